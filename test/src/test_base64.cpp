@@ -1,13 +1,64 @@
+#include <algorithm>
 #include <catch2/catch.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
 #include <string>
 #include <vector>
 
+#include "test_util.h"
 #include "utils/base64.h"
+#include "utils/base64_constexpr.h"
 
 using codec::base64_decode;
 using codec::base64_encode;
 using codec::base64_encode_mime;
 using codec::base64_encode_pem;
+using testutil::temp_path;
+
+namespace
+{
+// 逐位实现的参考编码器, 用于校验各 SIMD 内核的输出
+std::string reference_encode(const std::string &in, bool url)
+{
+  const char *chars = url ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+                          : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  size_t bits = 0;
+  unsigned int acc = 0;
+  for (unsigned char c : in)
+  {
+    acc = (acc << 8) | c;
+    bits += 8;
+    while (bits >= 6)
+    {
+      bits -= 6;
+      out.push_back(chars[(acc >> bits) & 0x3f]);
+    }
+  }
+  if (bits > 0) out.push_back(chars[(acc << (6 - bits)) & 0x3f]);
+  while (out.size() % 4 != 0) out.push_back(url ? '.' : '=');
+  return out;
+}
+
+// 与其他测试相同的生成器, 取第 16 ~ 23 位 (沿用本文件最初的测试数据)
+std::string pseudo_random_bytes(size_t n, unsigned int seed)
+{
+  return testutil::pseudo_random_data(n, seed, 16);
+}
+
+std::string read_file(const std::string &path)
+{
+  std::ifstream ifs(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+}
+
+void write_file(const std::string &path, const std::string &content)
+{
+  std::ofstream ofs(path, std::ios::binary);
+  ofs.write(content.data(), content.size());
+}
+}  // namespace
 
 TEST_CASE("base64: encode/decode basic string", "[base64]")
 {
@@ -75,6 +126,118 @@ TEST_CASE("base64: MIME encoding round-trip", "[base64][mime]")
   REQUIRE(decoded == input);
 }
 
+TEST_CASE("base64: PEM/MIME line breaks match the previous layout", "[base64][pem][mime]")
+{
+  // 与原先 "整体编码后每 N 个字符插入 '\n'" 的结果逐字节一致
+  auto insert_linebreaks = [](std::string str, size_t distance) {
+    for (size_t pos = distance; pos < str.size(); pos += distance + 1) str.insert(pos, "\n");
+    return str;
+  };
+
+  for (size_t len : {0, 1, 2, 47, 48, 49, 57, 58, 1000, 3071, 3072, 3073, 100000})
+  {
+    const std::string input = pseudo_random_bytes(len, static_cast<unsigned int>(len));
+    const std::string plain = base64_encode(input);
+    REQUIRE(base64_encode_pem(input) == insert_linebreaks(plain, 64));
+    REQUIRE(base64_encode_mime(input) == insert_linebreaks(plain, 76));
+    REQUIRE(base64_encode_pem(input).size() == codec::base64_encoded_size(len, 64));
+  }
+}
+
+TEST_CASE("base64: wrapped encoding with custom line length and CRLF", "[base64][pem][mime]")
+{
+  const std::string input = pseudo_random_bytes(5000, 5);
+  const std::string plain = base64_encode(input);
+
+  for (size_t line_length : {1, 3, 5, 64, 70, 76, 1000})
+  {
+    for (bool crlf : {false, true})
+    {
+      const std::string wrapped = codec::base64_encode_wrapped(input, line_length, crlf);
+      REQUIRE(wrapped.size() == codec::base64_encoded_size(input.size(), line_length, crlf));
+
+      // 去掉换行后与不换行的编码相同, 且除最后一行外每行长度都是 line_length
+      std::string joined;
+      bool full_lines = true;
+      size_t line_start = 0;
+      const std::string eol = crlf ? "\r\n" : "\n";
+      for (size_t pos = wrapped.find(eol); pos != std::string::npos; pos = wrapped.find(eol, line_start))
+      {
+        full_lines = full_lines && pos - line_start == line_length;
+        joined += wrapped.substr(line_start, pos - line_start);
+        line_start = pos + eol.size();
+      }
+      joined += wrapped.substr(line_start);
+      REQUIRE(full_lines);
+      REQUIRE(joined == plain);
+    }
+  }
+
+  REQUIRE(codec::base64_encode_wrapped(input, 0) == plain);
+  REQUIRE(base64_encode_mime(std::string(100, 'x'), true).find("\r\n") == 76);
+}
+
+TEST_CASE("base64: decode skips configured whitespace", "[base64][decode]")
+{
+  const std::string input = pseudo_random_bytes(10000, 17);
+
+  // 与 PEM/MIME 编码配合: 换行 (LF 或 CRLF) 在解码时直接跳过
+  REQUIRE(base64_decode(base64_encode_pem(input), true) == input);
+  REQUIRE(base64_decode(base64_encode_mime(input, true), true) == input);
+  REQUIRE(base64_decode(base64_encode_mime(input, true), codec::base64_skip::linebreaks) == input);
+
+  // 任意位置 (包括 4 字符块内部和填充之间) 的空白
+  std::string messy;
+  const std::string encoded = base64_encode(std::string("any carnal pleasure."));
+  const char ws[] = {' ', '\t', '\n', '\r'};
+  for (size_t i = 0; i < encoded.size(); ++i)
+  {
+    messy.push_back(ws[i % 4]);
+    messy.push_back(encoded[i]);
+  }
+  messy += "\r\n  ";
+  REQUIRE(base64_decode(messy, codec::base64_skip::whitespace) == "any carnal pleasure.");
+  REQUIRE_THROWS_AS(base64_decode(messy, codec::base64_skip::linebreaks), codec::base64_error);
+
+  // 只跳过选中的字符, 错误位置指向原始输入
+  try
+  {
+    base64_decode(std::string("Zm9v\nYm\tFy"), codec::base64_skip::lf | codec::base64_skip::cr);
+    FAIL("no exception thrown");
+  }
+  catch (const codec::base64_error &e)
+  {
+    REQUIRE(e.position() == 7);
+  }
+
+  // 大块输入: 空白随机分布, 非法字符的位置按原始输入计算
+  std::string sparse;
+  unsigned int seed = 1;
+  for (char c : base64_encode(input))
+  {
+    seed = seed * 1103515245U + 12345U;
+    if ((seed >> 16) % 7 == 0) sparse += (seed >> 8) % 2 == 0 ? "\r\n" : " \t";
+    sparse.push_back(c);
+  }
+  REQUIRE(base64_decode(sparse, codec::base64_skip::whitespace) == input);
+  const size_t bad = sparse.find_last_not_of(" \t\r\n", sparse.size() - 100);
+  sparse[bad] = '#';
+  try
+  {
+    base64_decode(sparse, codec::base64_skip::whitespace);
+    FAIL("no exception thrown");
+  }
+  catch (const codec::base64_error &e)
+  {
+    REQUIRE(e.position() == bad);
+  }
+
+  std::string out;
+  REQUIRE(codec::base64_decode_to(std::string(" Zm9v\r\nYmFy \n"), out, codec::base64_skip::whitespace) == 6);
+  REQUIRE(out == "foobar");
+  REQUIRE(base64_decode(std::string("\n\n"), true).empty());
+}
+
 TEST_CASE("base64: unsigned char buffer interface", "[base64][buffer]")
 {
   const std::vector<unsigned char> data = {0x00, 0x11, 0x22, 0x33, 0xFF};
@@ -102,12 +265,435 @@ TEST_CASE("base64: round-trip random-like data", "[base64][roundtrip]")
   REQUIRE(decoded == input);
 }
 
+TEST_CASE("base64: RFC 4648 test vectors", "[base64]")
+{
+  REQUIRE(base64_encode(std::string("")).empty());
+  REQUIRE(base64_encode(std::string("f")) == "Zg==");
+  REQUIRE(base64_encode(std::string("fo")) == "Zm8=");
+  REQUIRE(base64_encode(std::string("foo")) == "Zm9v");
+  REQUIRE(base64_encode(std::string("foob")) == "Zm9vYg==");
+  REQUIRE(base64_encode(std::string("fooba")) == "Zm9vYmE=");
+  REQUIRE(base64_encode(std::string("foobar")) == "Zm9vYmFy");
+  REQUIRE(base64_encode(std::string("foobar"), true) == "Zm9vYmFy");
+  REQUIRE(base64_encode(std::string("\xfb\xff"), true) == "-_8.");
+}
+
+TEST_CASE("base64: vectorized encode matches reference for all lengths", "[base64][simd]")
+{
+  // 覆盖 SIMD 主循环 (12/24/48 字节一块) 与标量尾部的所有组合
+  for (size_t len = 0; len < 300; ++len)
+  {
+    const std::string input = pseudo_random_bytes(len, static_cast<unsigned int>(len));
+    REQUIRE(base64_encode(input) == reference_encode(input, false));
+    REQUIRE(base64_encode(input, true) == reference_encode(input, true));
+  }
+
+  const std::string big = pseudo_random_bytes(1 << 20, 7);
+  REQUIRE(base64_encode(big) == reference_encode(big, false));
+  REQUIRE(base64_decode(base64_encode(big, true)) == big);
+}
+
 TEST_CASE("base64: invalid input throws", "[base64][invalid]")
 {
   const std::string invalid = "!!!!@@@@####";
   REQUIRE_THROWS(base64_decode(invalid));
 }
 
+TEST_CASE("base64: vectorized decode round-trip for all lengths", "[base64][simd]")
+{
+  for (size_t len = 0; len < 300; ++len)
+  {
+    const std::string input = pseudo_random_bytes(len, static_cast<unsigned int>(len) + 1000);
+    REQUIRE(base64_decode(reference_encode(input, false)) == input);
+    REQUIRE(base64_decode(reference_encode(input, true)) == input);
+  }
+}
+
+TEST_CASE("base64: decode is liberal with alphabet and padding", "[base64][decode]")
+{
+  // '+' '/' 与 '-' '_' 可以混用
+  const std::string input = pseudo_random_bytes(3000, 42);
+  std::string mixed = reference_encode(input, false);
+  for (size_t i = 0; i < mixed.size(); i += 2)
+  {
+    if (mixed[i] == '+') mixed[i] = '-';
+    if (mixed[i] == '/') mixed[i] = '_';
+  }
+  REQUIRE(base64_decode(mixed) == input);
+
+  // 填充可以是 '=' 或 '.', 也可以省略
+  REQUIRE(base64_decode(std::string("Zm9vYg==")) == "foob");
+  REQUIRE(base64_decode(std::string("Zm9vYg..")) == "foob");
+  REQUIRE(base64_decode(std::string("Zm9vYg")) == "foob");
+  REQUIRE(base64_decode(std::string("Zm9vYmE")) == "fooba");
+
+  // 拼接的编码串中间允许出现填充
+  REQUIRE(base64_decode(std::string("Zg==Zm8=Zm9v")) == "ffofoo");
+}
+
+TEST_CASE("base64: invalid input reports first offending offset", "[base64][invalid]")
+{
+  const std::string valid = reference_encode(pseudo_random_bytes(600, 3), false);
+  for (size_t bad : {0UL, 1UL, 5UL, 63UL, 100UL, 517UL, 799UL})
+  {
+    std::string s = valid;
+    s[bad] = '*';
+    try
+    {
+      base64_decode(s);
+      FAIL("no exception thrown");
+    }
+    catch (const codec::base64_error &e)
+    {
+      REQUIRE(e.position() == bad);
+    }
+  }
+
+  REQUIRE_THROWS_AS(base64_decode(std::string("Zm9vY")), codec::base64_error);     // 残留单个字符
+  REQUIRE_THROWS_AS(base64_decode(std::string("Zm9vY=Q=")), codec::base64_error);  // 填充后跟数据
+  REQUIRE_THROWS_AS(base64_decode(std::string("Zm9v\x80mFy")), std::runtime_error);
+}
+
+TEST_CASE("base64: validate and decoded length agree with decode", "[base64][validate]")
+{
+  const std::string inputs[] = {"", "Zg", "Zg==", "Zg=", "Zm8", "Zm8.", "Zm9v", "Zg==Zm8=Zm9v", "Zm9v\r\nYmFy\n",
+                                "Z", "Zm9v!", "Zg==a", "Z===", "Zg=a", "Zm9vYmFy\nZ"};
+
+  for (const std::string &s : inputs)
+  {
+    for (codec::base64_skip skip : {codec::base64_skip::none, codec::base64_skip::whitespace})
+    {
+      size_t error_pos = 0;
+      const bool valid = codec::base64_validate(s, skip, &error_pos);
+      try
+      {
+        const std::string decoded = base64_decode(s, skip);
+        REQUIRE(valid);
+        REQUIRE(error_pos == static_cast<size_t>(-1));
+        REQUIRE(codec::base64_decoded_length(s, skip) == decoded.size());
+      }
+      catch (const codec::base64_error &e)
+      {
+        REQUIRE_FALSE(valid);
+        REQUIRE(error_pos == e.position());
+      }
+    }
+  }
+
+  // 大块输入经过向量化内核, 非法字符在任意位置都能定位
+  std::string encoded = base64_encode(pseudo_random_bytes(3000, 11));
+  REQUIRE(codec::base64_validate(encoded));
+  REQUIRE(codec::base64_decoded_length(encoded) == 3000);
+  for (size_t bad : {0, 15, 16, 63, 64, 255, 256, 1000, 3999})
+  {
+    std::string copy = encoded;
+    copy[bad] = '\x80';
+    size_t error_pos = 0;
+    REQUIRE_FALSE(codec::base64_validate(copy.data(), copy.size(), codec::base64_skip::none, &error_pos));
+    REQUIRE(error_pos == bad);
+  }
+}
+
+TEST_CASE("base64: compile-time encode/decode of literals", "[base64][constexpr]")
+{
+  constexpr auto token = codec::base64_encode_literal("user:pass");
+  constexpr auto url_token = codec::base64_encode_literal("\xfb\xff\xfe\xfd", true);
+  constexpr auto empty = codec::base64_encode_literal("");
+  static_assert(token.size() == 12, "encoded length");
+  static_assert(empty.size() == 0, "empty literal");
+  REQUIRE(std::string(token.begin(), token.end()) == base64_encode(std::string("user:pass")));
+  REQUIRE(std::string(url_token.begin(), url_token.end()) == "-__-_Q..");
+
+  static_assert(codec::base64_literal_decoded_length("Zm9vYg==") == 4, "padding");
+  static_assert(codec::base64_literal_decoded_length("Zm9vYg") == 4, "no padding");
+  static_assert(codec::base64_literal_decoded_length("Zm9vYmE.") == 5, "url padding");
+  static_assert(codec::base64_literal_decoded_length("") == 0, "empty");
+
+  constexpr auto magic = UTILS_BASE64_DECODE("TVV0aWxz");
+  constexpr auto key = codec::base64_decode_literal<4>("3q2-7w..");
+  static_assert(magic.size() == 6, "decoded length");
+  REQUIRE(std::string(magic.begin(), magic.end()) == "MUtils");
+  REQUIRE(key == (std::array<unsigned char, 4>{{0xde, 0xad, 0xbe, 0xef}}));
+
+  // 所有长度与运行期实现一致
+  const char *samples[] = {"f", "fo", "foo", "foob", "fooba", "foobar"};
+  const auto f = codec::base64_encode_literal("foobar");
+  REQUIRE(std::string(f.begin(), f.end()) == base64_encode(std::string(samples[5])));
+  const auto fo = UTILS_BASE64_DECODE("Zm8");
+  REQUIRE(std::string(fo.begin(), fo.end()) == samples[1]);
+
+  // 运行期求值时非法输入抛出与 base64_decode() 相同的异常
+  REQUIRE_THROWS_AS(codec::base64_decode_literal<3>("Zm9!"), codec::base64_error);
+  REQUIRE_THROWS_AS(codec::base64_literal_decoded_length("Zm9vY"), codec::base64_error);
+  REQUIRE_THROWS_AS(codec::base64_decode_literal<2>("Zm9v"), std::length_error);
+}
+
+TEST_CASE("base64: encode_to/decode_to into caller buffers", "[base64][buffer]")
+{
+  REQUIRE(codec::base64_encoded_size(0) == 0);
+  REQUIRE(codec::base64_encoded_size(1) == 4);
+  REQUIRE(codec::base64_encoded_size(3) == 4);
+  REQUIRE(codec::base64_encoded_size(4) == 8);
+  REQUIRE(codec::base64_decoded_size(8) == 6);
+  REQUIRE(codec::base64_decoded_size(7) == 5);
+
+  const std::string input = pseudo_random_bytes(1000, 11);
+  const auto *bytes = reinterpret_cast<const unsigned char *>(input.data());
+
+  std::vector<char> enc(codec::base64_encoded_size(input.size()));
+  REQUIRE(codec::base64_encode_to(bytes, input.size(), enc.data(), enc.size(), true) == enc.size());
+  REQUIRE(std::string(enc.begin(), enc.end()) == base64_encode(input, true));
+  REQUIRE_THROWS_AS(codec::base64_encode_to(bytes, input.size(), enc.data(), enc.size() - 1), std::length_error);
+
+  std::vector<char> dec(codec::base64_decoded_size(enc.size()));
+  REQUIRE(codec::base64_decode_to(enc.data(), enc.size(), dec.data(), dec.size()) == input.size());
+  REQUIRE(std::string(dec.data(), input.size()) == input);
+
+  // 末尾填充不占输出空间, 恰好等于解码长度的缓冲区即可
+  char exact[1];
+  REQUIRE(codec::base64_decode_to("Zg==", 4, exact, sizeof(exact)) == 1);
+  REQUIRE(exact[0] == 'f');
+  REQUIRE_THROWS_AS(codec::base64_decode_to("Zm9v==", 6, exact, sizeof(exact)), std::length_error);
+
+  // std::string 版本追加到已有内容之后, 复用其容量
+  std::string out = "prefix:";
+  REQUIRE(codec::base64_encode_to(std::string("foobar"), out) == 8);
+  REQUIRE(out == "prefix:Zm9vYmFy");
+  out.clear();
+  REQUIRE(codec::base64_decode_to(std::string("Zm9vYg=="), out) == 4);
+  REQUIRE(codec::base64_decode_to(std::string("YmFy"), out) == 3);
+  REQUIRE(out == "foobbar");
+
+  REQUIRE_THROWS_AS(codec::base64_decode_to(std::string("Zm9v!"), out), codec::base64_error);
+  REQUIRE(out == "foobbar");
+}
+
+TEST_CASE("base64: decode in place", "[base64][inplace]")
+{
+  for (size_t len : {0, 1, 2, 3, 47, 48, 49, 100, 1000, 100000})
+  {
+    const std::string input = pseudo_random_bytes(len, static_cast<unsigned int>(len) + 3);
+
+    std::string buf = base64_encode(input, len % 2 == 0);
+    REQUIRE(codec::base64_decode_inplace(&buf[0], buf.size()) == len);
+    REQUIRE(buf.substr(0, len) == input);
+
+    std::string pem = base64_encode_pem(input);
+    REQUIRE(codec::base64_decode_inplace(pem, codec::base64_skip::linebreaks) == len);
+    REQUIRE(pem == input);
+  }
+
+  std::string concatenated = "Zg==Zm8=Zm9v";
+  REQUIRE(codec::base64_decode_inplace(concatenated) == 6);
+  REQUIRE(concatenated == "ffofoo");
+
+  std::string bad = base64_encode_mime(pseudo_random_bytes(1000, 1));
+  bad[700] = '*';
+  try
+  {
+    codec::base64_decode_inplace(bad, codec::base64_skip::linebreaks);
+    FAIL("no exception thrown");
+  }
+  catch (const codec::base64_error &e)
+  {
+    REQUIRE(e.position() == 700);
+  }
+}
+
+TEST_CASE("base64: streaming encoder/decoder with arbitrary chunk sizes", "[base64][stream]")
+{
+  const std::string input = pseudo_random_bytes(5000, 7);
+  const std::string expected = base64_encode(input);
+  const std::string wrapped = codec::base64_encode_mime(input, true);
+  const size_t chunk_sizes[] = {1, 2, 3, 4, 5, 7, 64, 1000, 4999};
+
+  for (size_t chunk : chunk_sizes)
+  {
+    codec::base64_encoder encoder;
+    std::string encoded;
+    for (size_t pos = 0; pos < input.size(); pos += chunk)
+    {
+      encoder.update(input.data() + pos, std::min(chunk, input.size() - pos), encoded);
+    }
+    encoder.finish(encoded);
+    REQUIRE(encoded == expected);
+
+    codec::base64_decoder decoder(codec::base64_skip::linebreaks);
+    std::string decoded;
+    for (size_t pos = 0; pos < wrapped.size(); pos += chunk)
+    {
+      decoder.update(wrapped.data() + pos, std::min(chunk, wrapped.size() - pos), decoded);
+    }
+    decoder.finish(decoded);
+    REQUIRE(decoded == input);
+  }
+
+  // 各种长度的尾部与填充 (含拼接的编码)
+  codec::base64_decoder decoder;
+  REQUIRE(decoder.update("Zg") == "");
+  REQUIRE(decoder.update("=") == "");
+  REQUIRE(decoder.update("=Zm8=") == "ffo");
+  REQUIRE(decoder.update("Zm9v") == "foo");
+  REQUIRE(decoder.update("Zm8") == "");
+  REQUIRE(decoder.finish() == "fo");
+
+  codec::base64_encoder encoder(true);
+  REQUIRE(encoder.update(std::string("\xfb")) == "");
+  REQUIRE(encoder.update(std::string("\xff\xfe\xfd")) == "-__-");
+  REQUIRE(encoder.finish() == "_Q..");
+  REQUIRE(encoder.finish() == "");
+}
+
+TEST_CASE("base64: streaming decoder reports absolute offsets", "[base64][stream][invalid]")
+{
+  const std::string bad[] = {"Zm9vYmFy\nZm9!", "Zm9vYmFy\nZ!9v", "Zm9vYm=y"};
+  const size_t expected[] = {12, 10, 7};
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    for (size_t split = 0; split <= bad[i].size(); ++split)
+    {
+      codec::base64_decoder decoder(codec::base64_skip::linebreaks);
+      std::string out;
+      try
+      {
+        decoder.update(bad[i].data(), split, out);
+        decoder.update(bad[i].data() + split, bad[i].size() - split, out);
+        decoder.finish(out);
+        FAIL("no base64_error thrown");
+      }
+      catch (const codec::base64_error &e)
+      {
+        REQUIRE(e.position() == expected[i]);
+      }
+    }
+  }
+
+  // 输入在单个字符处结束
+  codec::base64_decoder decoder;
+  decoder.update("Zm9vY");
+  try
+  {
+    decoder.finish();
+    FAIL("no base64_error thrown");
+  }
+  catch (const codec::base64_error &e)
+  {
+    REQUIRE(e.position() == 4);
+  }
+}
+
+TEST_CASE("base64: batch encoding into one buffer", "[base64][batch]")
+{
+  std::vector<std::string> values;
+  for (size_t i = 0; i < 3000; ++i)
+  {
+    // 16..200 字节为主, 夹杂空值和超过单个暂存块的大值
+    const size_t len = i % 500 == 7 ? 5000 + i : (i % 97 == 0 ? 0 : 16 + i * 7 % 185);
+    values.push_back(pseudo_random_bytes(len, static_cast<unsigned int>(i)));
+  }
+
+  for (bool url : {false, true})
+  {
+    std::string out;
+    std::vector<size_t> offsets;
+    const size_t total = codec::base64_encode_batch(values.data(), values.size(), out, offsets, url);
+    REQUIRE(total == out.size());
+    REQUIRE(offsets.size() == values.size() + 1);
+    REQUIRE(offsets.back() == out.size());
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      REQUIRE(out.substr(offsets[i], offsets[i + 1] - offsets[i]) == base64_encode(values[i], url));
+    }
+
+    std::vector<codec::base64_input> inputs;
+    for (const std::string &v : values)
+    {
+      inputs.push_back({reinterpret_cast<const unsigned char *>(v.data()), v.size()});
+    }
+    std::string out2;
+    codec::base64_encode_batch(inputs.data(), inputs.size(), out2, offsets, url);
+    REQUIRE(out2 == out);
+  }
+
+  std::string out = "old";
+  std::vector<size_t> offsets(5);
+  REQUIRE(codec::base64_encode_batch(static_cast<const std::string *>(nullptr), 0, out, offsets) == 0);
+  REQUIRE(out.empty());
+  REQUIRE(offsets.size() == 1);
+}
+
+TEST_CASE("base64: parallel encode/decode matches serial", "[base64][parallel]")
+{
+  for (size_t len : {0, 1, 1000, 3 * 1024 * 1024 + 1, 3 * 1024 * 1024 + 2})
+  {
+    const std::string input = pseudo_random_bytes(len, static_cast<unsigned int>(len));
+    const std::string expected = base64_encode(input, true);
+
+    for (unsigned int threads : {0U, 1U, 3U, 8U})
+    {
+      const std::string encoded = codec::base64_encode_parallel(input, true, threads, 0);
+      REQUIRE(encoded == expected);
+      REQUIRE(codec::base64_decode_parallel(encoded, threads, 0) == input);
+    }
+  }
+
+  // 中间带填充的拼接编码回退到单线程解码, 非法字符的位置不变
+  std::string concatenated;
+  for (int i = 0; i < 200000; ++i) concatenated += "Zm8=";
+  REQUIRE(codec::base64_decode_parallel(concatenated, 4, 0) == base64_decode(concatenated));
+
+  std::string bad = base64_encode(pseudo_random_bytes(2 * 1024 * 1024, 3));
+  bad[bad.size() / 2 + 1] = '*';
+  try
+  {
+    codec::base64_decode_parallel(bad, 4, 0);
+    FAIL("no exception thrown");
+  }
+  catch (const codec::base64_error &e)
+  {
+    REQUIRE(e.position() == bad.size() / 2 + 1);
+  }
+}
+
+TEST_CASE("base64: file to file encode/decode", "[base64][file]")
+{
+  const std::string plain_path = temp_path("plain");
+  const std::string encoded_path = temp_path("encoded");
+  const std::string decoded_path = temp_path("decoded");
+
+  for (size_t len : {0, 1, 2, 3, 1000, 3 * 256 * 1024 + 1, 2 * 1024 * 1024})
+  {
+    const std::string input = pseudo_random_bytes(len, static_cast<unsigned int>(len) + 1);
+    write_file(plain_path, input);
+
+    REQUIRE(codec::base64_encode_file(plain_path, encoded_path));
+    REQUIRE(read_file(encoded_path) == base64_encode(input));
+
+    REQUIRE(codec::base64_encode_file(plain_path, encoded_path, 76, true));
+    REQUIRE(read_file(encoded_path) == base64_encode_mime(input, true));
+
+    REQUIRE(codec::base64_decode_file(encoded_path, decoded_path));
+    REQUIRE(read_file(decoded_path) == input);
+  }
+
+  // 流式编码器的换行与一次性编码一致
+  const std::string input = pseudo_random_bytes(1000, 9);
+  codec::base64_encoder encoder(false, 64);
+  std::string wrapped;
+  for (size_t pos = 0; pos < input.size(); pos += 7) wrapped += encoder.update(input.substr(pos, 7));
+  wrapped += encoder.finish();
+  REQUIRE(wrapped == base64_encode_pem(input));
+
+  write_file(encoded_path, "Zm9v\nYm!y\n");
+  REQUIRE_THROWS_AS(codec::base64_decode_file(encoded_path, decoded_path), codec::base64_error);
+  REQUIRE_FALSE(codec::base64_encode_file(temp_path("missing/none"), decoded_path));
+
+  std::remove(plain_path.c_str());
+  std::remove(encoded_path.c_str());
+  std::remove(decoded_path.c_str());
+}
+
 #if __cplusplus >= 201703L
 TEST_CASE("base64: string_view interface", "[base64][string_view]")
 {
@@ -6,38 +6,89 @@
 //
 
 #include <catch2/catch.hpp>
-#include <fstream>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "checksum_simd.h"
+#include "test_util.h"
 #include "utils/check.h"
+#include "xxhash_simd.h"
 
 using namespace checkutils;
+using testutil::pseudo_random_data;
+using testutil::reference_crc;
+using testutil::write_temp_file;
 
 namespace
 {
 
-// 辅助函数：写临时文件
-std::string write_temp_file(const std::string &content)
+// 逐位计算的参考 CRC, 用于核对查表实现
+uint8_t reference_crc8(const std::string &data)
 {
-  static int idx = 0;
-#ifdef _WIN32
-  char *tmp_dir_buf = nullptr;
-  size_t len = 0;
-  errno_t err = _dupenv_s(&tmp_dir_buf, &len, "TMP");
-  if (err != 0 || (tmp_dir_buf == nullptr))
+  uint8_t crc = 0x00;
+  for (unsigned char c : data)
   {
-    err = _dupenv_s(&tmp_dir_buf, &len, "TEMP");
-    REQUIRE(tmp_dir_buf != nullptr);
+    crc ^= c;
+    for (int i = 0; i < 8; ++i) crc = ((crc & 0x80) != 0) ? (crc << 1) ^ 0x07 : (crc << 1);
   }
-  const std::string path = std::string(tmp_dir_buf) + "\\checkutils_test_" + std::to_string(idx++);
-  free(tmp_dir_buf);
-#else
-  const std::string path = "/tmp/checkutils_test_" + std::to_string(idx++);
-#endif
-  std::ofstream ofs(path, std::ios::binary);
-  REQUIRE(ofs.good());
-  ofs.write(content.data(), content.size());
-  return path;
+  return crc;
+}
+
+uint16_t reference_crc16(const std::string &data)
+{
+  uint16_t crc = 0xFFFF;
+  for (unsigned char c : data)
+  {
+    crc ^= c;
+    for (int i = 0; i < 8; ++i) crc = ((crc & 1) != 0) ? (crc >> 1) ^ 0xA001 : (crc >> 1);
+  }
+  return crc;
+}
+
+uint32_t reference_crc32(const std::string &data)
+{
+  uint32_t crc = 0xFFFFFFFF;
+  for (unsigned char c : data)
+  {
+    crc ^= c;
+    for (int i = 0; i < 8; ++i) crc = ((crc & 1) != 0) ? (crc >> 1) ^ 0xEDB88320 : (crc >> 1);
+  }
+  return ~crc;
+}
+
+uint32_t reference_crc32c(const std::string &data)
+{
+  uint32_t crc = 0xFFFFFFFF;
+  for (unsigned char c : data)
+  {
+    crc ^= c;
+    for (int i = 0; i < 8; ++i) crc = ((crc & 1) != 0) ? (crc >> 1) ^ 0x82F63B78 : (crc >> 1);
+  }
+  return ~crc;
+}
+
+// CRC-64/XZ 与 CRC-64/ECMA-182 按 Rocksoft 模型的参数
+uint64_t reference_crc64(const std::string &data)
+{
+  return reference_crc(64, 0x42F0E1EBA9EA3693, ~uint64_t(0), true, true, ~uint64_t(0), data);
+}
+
+uint64_t reference_crc64_ecma(const std::string &data)
+{
+  return reference_crc(64, 0x42F0E1EBA9EA3693, 0, false, false, 0, data);
+}
+
+// 逐字节取模的 Fletcher / Adler 参考实现
+uint32_t reference_fletcher(const std::string &data, uint32_t mod, uint32_t sum1, unsigned int shift)
+{
+  uint32_t sum2 = 0;
+  for (unsigned char c : data)
+  {
+    sum1 = (sum1 + c) % mod;
+    sum2 = (sum2 + sum1) % mod;
+  }
+  return (sum2 << shift) | sum1;
 }
 
 }  // namespace
@@ -67,6 +118,55 @@ TEST_CASE("checkutils: CRC16 MODBUS known vector", "[check][crc16]")
   REQUIRE(crc16(input) == 0x4B37);  // 标准测试向量
 }
 
+// ---------------- CRC 已知向量 ----------------
+TEST_CASE("checkutils: CRC known vectors", "[check][crc]")
+{
+  const std::string input = "123456789";
+  REQUIRE(crc8(input) == 0xF4);
+  REQUIRE(crc32(input) == 0xCBF43926);
+  REQUIRE(crc32c(input) == 0xE3069283);
+  REQUIRE(crc32c(std::string()) == 0);
+  REQUIRE(crc64(input) == 0x995DC9BBDF1939FA);
+  REQUIRE(crc64_ecma(input) == 0x6C40DF5F0B497347);
+  REQUIRE(crc64(std::string()) == 0);
+}
+
+// ---------------- 查表实现 ≡ 逐位实现 ----------------
+TEST_CASE("checkutils: CRC tables match bitwise reference", "[check][crc]")
+{
+  // 覆盖 16 字节分片与逐字节尾部的各种组合
+  for (size_t len = 0; len <= 300; ++len)
+  {
+    const std::string data = pseudo_random_data(len, static_cast<uint32_t>(len));
+    REQUIRE(crc8(data) == reference_crc8(data));
+    REQUIRE(crc16(data) == reference_crc16(data));
+    REQUIRE(crc32(data) == reference_crc32(data));
+    REQUIRE(crc32c(data) == reference_crc32c(data));
+    REQUIRE(crc64(data) == reference_crc64(data));
+    REQUIRE(crc64_ecma(data) == reference_crc64_ecma(data));
+  }
+
+  // 长输入: 硬件路径的多路折叠/交错分段与尾部
+  for (size_t len : {1024, 6143, 6144, 6145, 7000, 12345, 65536 + 77})
+  {
+    const std::string data = pseudo_random_data(len, static_cast<uint32_t>(len));
+    REQUIRE(crc32(data) == reference_crc32(data));
+    REQUIRE(crc32c(data) == reference_crc32c(data));
+    REQUIRE(crc64(data) == reference_crc64(data));
+    REQUIRE(crc64_ecma(data) == reference_crc64_ecma(data));
+  }
+
+  // 跨越文件读取缓冲区边界
+  const std::string data = pseudo_random_data(100000, 7);
+  const std::string path = write_temp_file(data);
+  REQUIRE(crc8_file(path) == reference_crc8(data));
+  REQUIRE(crc16_file(path) == reference_crc16(data));
+  REQUIRE(crc32_file(path) == reference_crc32(data));
+  REQUIRE(crc32c_file(path) == reference_crc32c(data));
+  REQUIRE(crc64_file(path) == reference_crc64(data));
+  REQUIRE(crc64_ecma_file(path) == reference_crc64_ecma(data));
+}
+
 // ---------------- sum / xor / lrc ----------------
 TEST_CASE("checkutils: sum / xor / lrc basic", "[check][sum][xor][lrc]")
 {
@@ -80,6 +180,71 @@ TEST_CASE("checkutils: sum / xor / lrc basic", "[check][sum][xor][lrc]")
   REQUIRE(lrc8(data) == expected_lrc);
 }
 
+TEST_CASE("checkutils: sum / xor / lrc match byte-wise reference", "[check][sum][xor][lrc]")
+{
+  // 覆盖向量块与尾部的各种组合, 以及较长的全 0xFF 输入
+  std::vector<std::string> inputs;
+  for (size_t len = 0; len <= 300; ++len) inputs.push_back(pseudo_random_data(len, static_cast<uint32_t>(len)));
+  inputs.push_back(pseudo_random_data(100003, 9));
+  inputs.push_back(std::string(100003, '\xFF'));
+
+  for (const std::string &data : inputs)
+  {
+    uint8_t s8 = 0;
+    uint16_t s16 = 0;
+    uint8_t x8 = 0;
+    for (unsigned char c : data)
+    {
+      s8 = static_cast<uint8_t>(s8 + c);
+      s16 = static_cast<uint16_t>(s16 + c);
+      x8 ^= c;
+    }
+    REQUIRE(sum8(data) == s8);
+    REQUIRE(sum16(data) == s16);
+    REQUIRE(xor8(data) == x8);
+    REQUIRE(lrc8(data) == static_cast<uint8_t>(-s8));
+  }
+}
+
+#if UTILS_X86_SIMD
+// 有 AVX2 时运行时分派不会选择 SSE2 内核, 这里直接调用各内核, 与逐字节计算的前缀结果比较
+TEST_CASE("checkutils: sum / xor kernels match byte-wise reference", "[check][sum][xor][simd]")
+{
+  std::vector<std::pair<detail::sum_kernel, detail::xor_kernel>> kernels;
+  if (cpu::features().sse2) kernels.emplace_back(detail::sum_sse2, detail::xor_sse2);
+  if (cpu::features().avx2) kernels.emplace_back(detail::sum_avx2, detail::xor_avx2);
+
+  std::vector<std::string> inputs;
+  for (size_t len : {0, 1, 63, 64, 65, 127, 128, 129, 300, 4096, 100003})
+    inputs.push_back(pseudo_random_data(len, static_cast<uint32_t>(len) + 5));
+  inputs.push_back(std::string(100003, '\xFF'));
+
+  for (const std::string &data : inputs)
+  {
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(data.data());
+    for (const auto &kernel : kernels)
+    {
+      // 内核在调用方已有的值上继续累加, 只处理块大小整数倍的前缀
+      uint64_t sum = 1000;
+      uint8_t val = 0x5A;
+      const size_t summed = kernel.first(sum, p, data.size());
+      const size_t xored = kernel.second(val, p, data.size());
+      REQUIRE(summed <= data.size());
+      REQUIRE(data.size() - summed < 128);
+      REQUIRE(xored <= data.size());
+      REQUIRE(data.size() - xored < 128);
+
+      uint64_t expected_sum = 1000;
+      uint8_t expected_val = 0x5A;
+      for (size_t i = 0; i < summed; ++i) expected_sum += p[i];
+      for (size_t i = 0; i < xored; ++i) expected_val ^= p[i];
+      REQUIRE(sum == expected_sum);
+      REQUIRE(val == expected_val);
+    }
+  }
+}
+#endif  // UTILS_X86_SIMD
+
 // ---------------- Fletcher 校验 ----------------
 TEST_CASE("checkutils: fletcher basic properties", "[check][fletcher]")
 {
@@ -92,6 +257,167 @@ TEST_CASE("checkutils: fletcher basic properties", "[check][fletcher]")
   REQUIRE(fletcher32(data) != 0);
 }
 
+TEST_CASE("checkutils: fletcher and adler32 match byte-wise modulo", "[check][fletcher][adler]")
+{
+  REQUIRE(adler32("Wikipedia") == 0x11E60398);
+  REQUIRE(adler32("123456789") == 0x091E01DE);
+  REQUIRE(adler32(std::string()) == 1);
+
+  auto check = [](const std::string &data) {
+    REQUIRE(fletcher16(data) == reference_fletcher(data, 255, 0, 8));
+    REQUIRE(fletcher32(data) == reference_fletcher(data, 65535, 0, 16));
+    REQUIRE(adler32(data) == reference_fletcher(data, 65521, 1, 16));
+  };
+
+  // 覆盖 32 字节向量块与尾部的各种组合
+  for (size_t len = 0; len <= 300; ++len) check(pseudo_random_data(len, static_cast<uint32_t>(len)));
+
+  // 跨越取模分块 (5552 字节) 的边界; 全 0xFF 时和增长最快
+  for (size_t len : {5551, 5552, 5553, 11104, 11137, 100000})
+  {
+    check(pseudo_random_data(len, static_cast<uint32_t>(len)));
+    check(std::string(len, '\xFF'));
+  }
+
+  const std::string data = pseudo_random_data(100000, 3);
+  const std::string path = write_temp_file(data);
+  REQUIRE(adler32_file(path) == adler32(data));
+}
+
+// ---------------- xxHash ----------------
+TEST_CASE("checkutils: xxhash matches reference vectors", "[check][xxhash]")
+{
+  // 期望值来自 xxHash 参考实现 (libxxhash 0.8)
+  REQUIRE(xxh64("") == 0xEF46DB3751D8E999ULL);
+  REQUIRE(xxh3_64("") == 0x2D06800538D394C2ULL);
+  REQUIRE(xxh3_128("") == (hash128{0x6001C324468D497FULL, 0x99AA06D3014798D8ULL}));
+  REQUIRE(xxh64("123456789") == 0x8CB841DB40E6AE83ULL);
+  REQUIRE(xxh3_64("123456789") == 0x72DCB18B67A17DFFULL);
+  REQUIRE(xxh3_128("123456789") == (hash128{0xE9716427681D5860ULL, 0x33119477EDE5DCD5ULL}));
+  REQUIRE(xxh64("123456789", 42) == 0xA18395713E7331F3ULL);
+  REQUIRE(xxh3_64("123456789", 42) == 0x6F803E3C27E6DA22ULL);
+
+  // 覆盖 XXH3 的各个长度分支; 偶数长度使用非 0 种子
+  struct vector
+  {
+    size_t len;
+    uint64_t xxh64;
+    uint64_t xxh3_64;
+    uint64_t xxh3_128_low;
+    uint64_t xxh3_128_high;
+  };
+  const vector vectors[] = {
+    {1, 0x13099D40D095B684ULL, 0xD0D496E05C553485ULL, 0xD0D496E05C553485ULL, 0x9B0498CBE3839BECULL},
+    {3, 0xA8E19F424AB1FB1AULL, 0x35C8B8CB9DAA8C4BULL, 0x35C8B8CB9DAA8C4BULL, 0xA1A97225F19A4035ULL},
+    {4, 0x9E20B73288B6F1FEULL, 0x3B66AE15810522B9ULL, 0xC49E7BAAF09EF562ULL, 0xCF6F6A03825F8E2BULL},
+    {8, 0x42804C8838DAE1CDULL, 0x7059BCE236C408A5ULL, 0xB058229C0C68BF6CULL, 0xAB705DCFCE8BE7FDULL},
+    {9, 0x602A180F029650EAULL, 0x04D746E73B7E0EAEULL, 0xD6E6992E778193EAULL, 0x3C9655A55F94100BULL},
+    {16, 0x4E8A39E98CBB5E86ULL, 0xC366D8773FF9C570ULL, 0x23D0DB0ECE28E317ULL, 0x2541BAED4DD6D6C2ULL},
+    {17, 0xAF954E15B27046D4ULL, 0x90503A7E3B745236ULL, 0x50479335832C7D02ULL, 0xE830B4068679562AULL},
+    {128, 0xCF4C9C04BE56E223ULL, 0x7B16687D98C379AEULL, 0x92F7047F5CE4139EULL, 0x2811C15FB04656A4ULL},
+    {129, 0x3FE852C1BD2399F7ULL, 0x5101E553E46CF46BULL, 0x62118AC6C326884BULL, 0x953F98034165F9AFULL},
+    {240, 0xF7C3B2F67E74349EULL, 0xF685D03106C5C51AULL, 0x4CD4ACDA49EDA3B3ULL, 0x95D9070A372BD717ULL},
+    {241, 0xF08D2368E842CD9BULL, 0xB21A6BBBAE7ED0EDULL, 0xB21A6BBBAE7ED0EDULL, 0xB36B9A3CBB980D61ULL},
+    {1024, 0xB63A35CF7996078CULL, 0xEAD69CC079C71BB1ULL, 0xEAD69CC079C71BB1ULL, 0x59C25F8547A6F54BULL},
+    {1025, 0x097EF5221F4BF80CULL, 0x64D3C9CCAFA72DA4ULL, 0x64D3C9CCAFA72DA4ULL, 0xE7318F5882EE5902ULL},
+    {5000, 0x83F57E34110067D3ULL, 0xF01D74D722B2C104ULL, 0xF01D74D722B2C104ULL, 0x8401178E80A00D32ULL},
+  };
+  for (const vector &v : vectors)
+  {
+    const std::string data = pseudo_random_data(v.len, static_cast<uint32_t>(v.len));
+    const uint64_t seed = v.len % 2 != 0 ? 0 : 0x9E3779B97F4A7C15ULL;
+    REQUIRE(xxh64(data, seed) == v.xxh64);
+    REQUIRE(xxh3_64(data, seed) == v.xxh3_64);
+    REQUIRE(xxh3_128(data, seed) == (hash128{v.xxh3_128_low, v.xxh3_128_high}));
+  }
+}
+
+#if UTILS_X86_SIMD
+// 有 AVX2 时运行时分派不会选择 SSE2 内核, 这里直接调用各内核, 与逐 lane 计算的 stripe 累加比较
+TEST_CASE("checkutils: xxh3 accumulate kernels match scalar", "[check][xxhash][simd]")
+{
+  std::vector<detail::xxh3_accumulate_kernel> kernels;
+  if (cpu::features().sse2) kernels.push_back(detail::xxh3_accumulate_sse2);
+  if (cpu::features().avx2) kernels.push_back(detail::xxh3_accumulate_avx2);
+
+  auto read64 = [](const std::string &s, size_t pos) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < 8; ++i) v |= static_cast<uint64_t>(static_cast<unsigned char>(s[pos + i])) << (8 * i);
+    return v;
+  };
+
+  for (size_t stripes = 1; stripes <= 20; ++stripes)
+  {
+    const std::string input = pseudo_random_data(stripes * detail::xxh3_stripe_len, static_cast<uint32_t>(stripes));
+    const std::string secret = pseudo_random_data(detail::xxh3_stripe_len + stripes * detail::xxh3_secret_consume_rate,
+                                                  static_cast<uint32_t>(stripes) + 100);
+    const std::string init = pseudo_random_data(64, static_cast<uint32_t>(stripes) + 200);
+
+    uint64_t expected[8];
+    for (size_t i = 0; i < 8; ++i) expected[i] = read64(init, 8 * i);
+    for (size_t n = 0; n < stripes; ++n)
+    {
+      for (size_t i = 0; i < 8; ++i)
+      {
+        const uint64_t data = read64(input, n * detail::xxh3_stripe_len + 8 * i);
+        const uint64_t data_key = data ^ read64(secret, n * detail::xxh3_secret_consume_rate + 8 * i);
+        expected[i ^ 1] += data;
+        expected[i] += (data_key & 0xFFFFFFFF) * (data_key >> 32);
+      }
+    }
+
+    for (detail::xxh3_accumulate_kernel kernel : kernels)
+    {
+      uint64_t acc[8];
+      for (size_t i = 0; i < 8; ++i) acc[i] = read64(init, 8 * i);
+      kernel(acc, reinterpret_cast<const unsigned char *>(input.data()),
+             reinterpret_cast<const unsigned char *>(secret.data()), stripes);
+      for (size_t i = 0; i < 8; ++i) REQUIRE(acc[i] == expected[i]);
+    }
+  }
+}
+#endif  // UTILS_X86_SIMD
+
+TEST_CASE("checkutils: xxhash streaming matches one-shot", "[check][xxhash][hasher]")
+{
+  auto check = [](const std::string &data, uint64_t seed, size_t step) {
+    xxh64_hasher h64(seed);
+    xxh3_64_hasher h3(seed);
+    xxh3_128_hasher h128(seed);
+    for (size_t pos = 0; pos < data.size(); pos += step)
+    {
+      const std::string piece = data.substr(pos, step);
+      h64.update(piece);
+      h3.update(piece);
+      h128.update(piece);
+    }
+    REQUIRE(h64.value() == xxh64(data, seed));
+    REQUIRE(h3.value() == xxh3_64(data, seed));
+    REQUIRE(h128.value() == xxh3_128(data, seed));
+  };
+
+  // 内部缓冲 32 / 256 字节, 每块 1024 字节; 覆盖缓冲填满、跨块与最后一个 stripe 借用已处理数据的情况
+  for (size_t len = 0; len <= 600; ++len)
+  {
+    const std::string data = pseudo_random_data(len, static_cast<uint32_t>(len));
+    check(data, 0, 7);
+    check(data, 12345, 64);
+  }
+  const std::string data = pseudo_random_data(100000, 9);
+  for (size_t step : {1, 31, 32, 63, 64, 65, 255, 256, 257, 1024, 4096, 100000}) check(data, step, step);
+
+  xxh3_128_hasher hasher(5);
+  hasher.update(data);
+  hasher.reset();
+  REQUIRE(hasher.value() == xxh3_128("", 5));
+
+  const std::string path = write_temp_file(data);
+  REQUIRE(xxh64_file(path) == xxh64(data));
+  REQUIRE(xxh3_64_file(path, 77) == xxh3_64(data, 77));
+  REQUIRE(xxh3_128_file(path) == xxh3_128(data));
+  REQUIRE(xxh3_128_file("/nonexistent/checkutils_test") == (hash128{0, 0}));
+}
+
 // ---------------- 文件接口 ≡ 内存接口 ----------------
 TEST_CASE("checkutils: file and memory results match", "[check][file]")
 {
@@ -131,3 +457,178 @@ TEST_CASE("checkutils: binary data", "[check][binary]")
   REQUIRE(fletcher16(data) == fletcher16(data));
   REQUIRE(fletcher32(data) == fletcher32(data));
 }
+
+// ---------------- 增量计算 ≡ 一次计算 ----------------
+TEST_CASE("checkutils: incremental hashers", "[check][hasher]")
+{
+  const std::string data = pseudo_random_data(5000, 42);
+
+  // 按不同的分段长度送入, 包括 0 长度的分段
+  for (size_t step : {size_t(1), size_t(3), size_t(16), size_t(63), size_t(1000), size_t(5000)})
+  {
+    crc8_hasher h_crc8;
+    crc16_hasher h_crc16;
+    crc32_hasher h_crc32;
+    crc32c_hasher h_crc32c;
+    crc64_hasher h_crc64;
+    crc64_ecma_hasher h_crc64_ecma;
+    sum8_hasher h_sum8;
+    sum16_hasher h_sum16;
+    xor8_hasher h_xor8;
+    lrc8_hasher h_lrc8;
+    fletcher16_hasher h_fletcher16;
+    fletcher32_hasher h_fletcher32;
+    adler32_hasher h_adler32;
+    for (size_t pos = 0; pos < data.size(); pos += step)
+    {
+      const std::string piece = data.substr(pos, step);
+      h_crc8.update(piece);
+      h_crc16.update(piece);
+      h_crc32.update(piece.data(), piece.size());
+      h_crc32.update(piece.data(), 0);
+      h_crc32c.update(piece);
+      h_crc64.update(piece);
+      h_crc64_ecma.update(piece);
+      h_sum8.update(piece);
+      h_sum16.update(piece);
+      h_xor8.update(piece);
+      h_lrc8.update(piece);
+      h_fletcher16.update(piece);
+      h_fletcher32.update(piece);
+      h_adler32.update(piece);
+    }
+    REQUIRE(h_crc8.value() == crc8(data));
+    REQUIRE(h_crc16.value() == crc16(data));
+    REQUIRE(h_crc32.value() == crc32(data));
+    REQUIRE(h_crc32c.value() == crc32c(data));
+    REQUIRE(h_crc64.value() == crc64(data));
+    REQUIRE(h_crc64_ecma.value() == crc64_ecma(data));
+    REQUIRE(h_sum8.value() == sum8(data));
+    REQUIRE(h_sum16.value() == sum16(data));
+    REQUIRE(h_xor8.value() == xor8(data));
+    REQUIRE(h_lrc8.value() == lrc8(data));
+    REQUIRE(h_fletcher16.value() == fletcher16(data));
+    REQUIRE(h_fletcher32.value() == fletcher32(data));
+    REQUIRE(h_adler32.value() == adler32(data));
+  }
+
+  // 初始值与空输入一致, reset() 之后可以复用
+  crc16_hasher h16;
+  REQUIRE(h16.value() == crc16(std::string()));
+  fletcher32_hasher hf;
+  hf.update("abcdef", 6);
+  hf.reset();
+  REQUIRE(hf.value() == fletcher32(std::string()));
+  hf.update("abcdef", 6);
+  REQUIRE(hf.value() == fletcher32("abcdef"));
+}
+
+// ---------------- CRC 合并与多线程文件计算 ----------------
+TEST_CASE("checkutils: crc combine", "[check][crc][combine]")
+{
+  const std::string data = pseudo_random_data(3000, 99);
+  for (size_t split : {size_t(0), size_t(1), size_t(15), size_t(64), size_t(1500), size_t(2999), size_t(3000)})
+  {
+    const std::string a = data.substr(0, split);
+    const std::string b = data.substr(split);
+    REQUIRE(crc32_combine(crc32(a), crc32(b), b.size()) == crc32(data));
+    REQUIRE(crc32c_combine(crc32c(a), crc32c(b), b.size()) == crc32c(data));
+  }
+
+  // 超过 4 GiB 的段长: 合并满足结合律
+  const uint32_t a = 0x12345678;
+  const uint32_t b = 0x9ABCDEF0;
+  const uint32_t c = 0x0F1E2D3C;
+  const uint64_t len_b = 5000000000ULL;
+  const uint64_t len_c = 3000000001ULL;
+  REQUIRE(crc32_combine(crc32_combine(a, b, len_b), c, len_c) ==
+          crc32_combine(a, crc32_combine(b, c, len_c), len_b + len_c));
+  REQUIRE(crc32c_combine(crc32c_combine(a, b, len_b), c, len_c) ==
+          crc32c_combine(a, crc32c_combine(b, c, len_c), len_b + len_c));
+}
+
+TEST_CASE("checkutils: parallel file crc", "[check][crc][file]")
+{
+  const std::string data = pseudo_random_data(4 * 1024 * 1024 + 12345, 3);
+  const std::string path = write_temp_file(data);
+
+  for (unsigned int threads : {1U, 2U, 3U, 4U, 0U})
+  {
+    REQUIRE(crc32_file_parallel(path, threads, 0) == crc32(data));
+    REQUIRE(crc32c_file_parallel(path, threads, 0) == crc32c(data));
+  }
+  REQUIRE(crc32_file_parallel(path) == crc32(data));  // 小于阈值, 在调用线程上计算
+
+  const std::string small = write_temp_file("small");
+  REQUIRE(crc32_file_parallel(small, 4, 0) == crc32("small"));
+  REQUIRE(crc32_file_parallel("/nonexistent/checkutils_test", 4, 0) == 0);
+}
+
+// ---------------- 文件读取方式 ----------------
+TEST_CASE("checkutils: file buffer sizes and special files", "[check][file]")
+{
+  const std::string data = pseudo_random_data(300000, 11);
+  const std::string path = write_temp_file(data);
+
+  for (size_t buffer_size : {size_t(0), size_t(1), size_t(4096), size_t(65537), size_t(1) << 22})
+  {
+    REQUIRE(crc32_file(path, buffer_size) == crc32(data));
+    REQUIRE(fletcher16_file(path, buffer_size) == fletcher16(data));
+  }
+
+  // 空文件
+  const std::string empty = write_temp_file("");
+  REQUIRE(crc32_file(empty) == crc32(""));
+  REQUIRE(crc16_file(empty) == crc16(""));
+
+  REQUIRE(crc32_file("/nonexistent/checkutils_test") == 0);
+#ifndef _WIN32
+  // 设备文件无法映射, 按块读取
+  REQUIRE(crc32_file("/dev/null", 4096) == crc32(""));
+#endif
+}
+
+// ---------------- 一次读取计算多种校验 ----------------
+TEST_CASE("checkutils: multiple checksums in one pass", "[check][multi]")
+{
+  const std::string data = pseudo_random_data(200000, 5);
+
+  const checksums all = multi_checksum(data, checksum::all);
+  REQUIRE(all.crc8 == crc8(data));
+  REQUIRE(all.crc16 == crc16(data));
+  REQUIRE(all.crc32 == crc32(data));
+  REQUIRE(all.crc32c == crc32c(data));
+  REQUIRE(all.sum8 == sum8(data));
+  REQUIRE(all.sum16 == sum16(data));
+  REQUIRE(all.xor8 == xor8(data));
+  REQUIRE(all.lrc8 == lrc8(data));
+  REQUIRE(all.fletcher16 == fletcher16(data));
+  REQUIRE(all.fletcher32 == fletcher32(data));
+  REQUIRE(all.crc64 == crc64(data));
+  REQUIRE(all.crc64_ecma == crc64_ecma(data));
+  REQUIRE(all.adler32 == adler32(data));
+  REQUIRE(all.xxh64 == xxh64(data));
+  REQUIRE(all.xxh3_64 == xxh3_64(data));
+  REQUIRE(all.xxh3_128 == xxh3_128(data));
+
+  // 只计算选中的校验, 其余字段为 0
+  const std::string path = write_temp_file(data);
+  checksums some;
+  REQUIRE(multi_checksum_file(path, checksum::crc32 | checksum::crc16 | checksum::fletcher32, some));
+  REQUIRE(some.crc32 == crc32(data));
+  REQUIRE(some.crc16 == crc16(data));
+  REQUIRE(some.fletcher32 == fletcher32(data));
+  REQUIRE(some.crc8 == 0);
+  REQUIRE(some.sum16 == 0);
+
+  // 增量计算
+  multi_hasher hasher(checksum::all);
+  hasher.update(data.substr(0, 777));
+  hasher.update(data.data() + 777, data.size() - 777);
+  REQUIRE(hasher.value().crc32c == all.crc32c);
+  REQUIRE(hasher.value().fletcher16 == all.fletcher16);
+  hasher.reset();
+  REQUIRE(hasher.value().crc16 == crc16(""));
+
+  REQUIRE_FALSE(multi_checksum_file("/nonexistent/checkutils_test", checksum::all, some));
+}
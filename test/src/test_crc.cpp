@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+//
+// Catch2 v2.13.x 测试文件
+// 对通用 CRC 模板 checkutils::crc<...> 及其预置变体进行测试
+//
+
+#include <catch2/catch.hpp>
+#include <string>
+
+#include "test_util.h"
+#include "utils/check.h"
+#include "utils/crc.h"
+
+using namespace checkutils;
+using testutil::pseudo_random_data;
+using testutil::reference_crc;
+
+namespace
+{
+
+template <typename Crc>
+void check_variant(unsigned int width, uint64_t poly, uint64_t init, bool refin, bool refout, uint64_t xorout,
+                   uint64_t check)
+{
+  const std::string input = "123456789";
+  REQUIRE(Crc::compute(input) == check);
+  REQUIRE(Crc::initial_value() == Crc::compute(""));
+
+  // 覆盖 16 字节分片与逐字节尾部的各种组合
+  for (size_t len = 0; len <= 70; ++len)
+  {
+    const std::string data = pseudo_random_data(len, static_cast<uint32_t>(len + width));
+    REQUIRE(Crc::compute(data) == reference_crc(width, poly, init, refin, refout, xorout, data));
+  }
+
+  // 增量计算与继续计算
+  const std::string data = pseudo_random_data(1000, width);
+  Crc hasher;
+  hasher.update(data.substr(0, 123));
+  hasher.update(data.data() + 123, data.size() - 123);
+  REQUIRE(hasher.value() == Crc::compute(data));
+  REQUIRE(Crc::extend(Crc::compute(data.substr(0, 517)), data.data() + 517, data.size() - 517) == hasher.value());
+  hasher.reset();
+  REQUIRE(hasher.value() == Crc::initial_value());
+}
+
+}  // namespace
+
+TEST_CASE("crc: catalog check values and reference", "[crc]")
+{
+  // 校验值来自 CRC RevEng 目录 ("123456789")
+  check_variant<crc_catalog::crc3_gsm>(3, 0x3, 0x0, false, false, 0x7, 0x4);
+  check_variant<crc_catalog::crc5_usb>(5, 0x05, 0x1F, true, true, 0x1F, 0x19);
+  check_variant<crc_catalog::crc8_smbus>(8, 0x07, 0x00, false, false, 0x00, 0xF4);
+  check_variant<crc_catalog::crc8_maxim>(8, 0x31, 0x00, true, true, 0x00, 0xA1);
+  check_variant<crc_catalog::crc8_autosar>(8, 0x2F, 0xFF, false, false, 0xFF, 0xDF);
+  check_variant<crc_catalog::crc12_umts>(12, 0x80F, 0x000, false, true, 0x000, 0xDAF);
+  check_variant<crc_catalog::crc15_can>(15, 0x4599, 0x0000, false, false, 0x0000, 0x059E);
+  check_variant<crc_catalog::crc16_modbus>(16, 0x8005, 0xFFFF, true, true, 0x0000, 0x4B37);
+  check_variant<crc_catalog::crc16_arc>(16, 0x8005, 0x0000, true, true, 0x0000, 0xBB3D);
+  check_variant<crc_catalog::crc16_usb>(16, 0x8005, 0xFFFF, true, true, 0xFFFF, 0xB4C8);
+  check_variant<crc_catalog::crc16_ccitt_false>(16, 0x1021, 0xFFFF, false, false, 0x0000, 0x29B1);
+  check_variant<crc_catalog::crc16_xmodem>(16, 0x1021, 0x0000, false, false, 0x0000, 0x31C3);
+  check_variant<crc_catalog::crc16_kermit>(16, 0x1021, 0x0000, true, true, 0x0000, 0x2189);
+  check_variant<crc_catalog::crc16_x25>(16, 0x1021, 0xFFFF, true, true, 0xFFFF, 0x906E);
+  check_variant<crc_catalog::crc32_iso_hdlc>(32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0xCBF43926);
+  check_variant<crc_catalog::crc32_iscsi>(32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0xE3069283);
+  check_variant<crc_catalog::crc32_bzip2>(32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF, 0xFC891918);
+  check_variant<crc_catalog::crc32_mpeg2>(32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0x00000000, 0x0376E6E7);
+  check_variant<crc_catalog::crc32_cksum>(32, 0x04C11DB7, 0x00000000, false, false, 0xFFFFFFFF, 0x765E7680);
+  check_variant<crc_catalog::crc64_xz>(64, 0x42F0E1EBA9EA3693, ~uint64_t(0), true, true, ~uint64_t(0),
+                                       0x995DC9BBDF1939FA);
+  check_variant<crc_catalog::crc64_ecma_182>(64, 0x42F0E1EBA9EA3693, 0, false, false, 0, 0x6C40DF5F0B497347);
+}
+
+TEST_CASE("crc: presets match the checkutils functions", "[crc]")
+{
+  const std::string data = pseudo_random_data(5000, 1);
+  REQUIRE(crc_catalog::crc8_smbus::compute(data) == crc8(data));
+  REQUIRE(crc_catalog::crc16_modbus::compute(data) == crc16(data));
+  REQUIRE(crc_catalog::crc32_iso_hdlc::compute(data) == crc32(data));
+  REQUIRE(crc_catalog::crc32_iscsi::compute(data) == crc32c(data));
+}
+
+TEST_CASE("crc: user-defined parameters", "[crc]")
+{
+  // 目录中未预置的变体: CRC-24/OPENPGP
+  using crc24_openpgp = crc<24, 0x864CFB, 0xB704CE, false, false, 0x000000>;
+  REQUIRE(crc24_openpgp::width == 24);
+  REQUIRE(crc24_openpgp::compute("123456789") == 0x21CF02);
+}
@@ -0,0 +1,212 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+//
+// Catch2 v2.13.x 测试文件
+// 对 SHA-256 / SHA-1 / MD5 摘要进行测试
+//
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+
+#include "digest_simd.h"
+#include "test_util.h"
+#include "utils/digest.h"
+
+using namespace checkutils;
+using testutil::pseudo_random_data;
+using testutil::write_temp_file;
+
+namespace
+{
+
+template <typename Hasher, typename Digest>
+void check_streaming(const std::string &data, size_t step, const Digest &expected)
+{
+  Hasher hasher;
+  for (size_t pos = 0; pos < data.size(); pos += step) hasher.update(data.substr(pos, step));
+  REQUIRE(hasher.value() == expected);
+}
+
+#if UTILS_X86_SIMD
+// 按摘要算法填充: 0x80、若干 0 与 64 bit 的消息长度 (bit)
+std::string pad_message(const std::string &message, bool big_endian)
+{
+  std::string padded = message + '\x80';
+  while (padded.size() % 64 != 56) padded.push_back('\0');
+  const uint64_t bits = static_cast<uint64_t>(message.size()) * 8;
+  for (int i = 0; i < 8; ++i) padded.push_back(static_cast<char>(bits >> (big_endian ? 56 - 8 * i : 8 * i)));
+  return padded;
+}
+
+// 8 条填充后同为 blocks 块的消息交给多消息内核, 每个 lane 的链接值即为该消息的摘要
+template <size_t Words, typename Digest>
+void check_multi_kernel(detail::multi_block_kernel kernel, const uint32_t (&iv)[Words], bool big_endian,
+                        Digest (*digest)(const std::string &))
+{
+  const size_t lanes = detail::digest_lanes;
+  for (size_t blocks = 1; blocks <= 16; ++blocks)
+  {
+    std::vector<std::string> messages;
+    std::vector<std::string> padded;
+    for (size_t lane = 0; lane < lanes; ++lane)
+    {
+      const size_t len = 64 * blocks - 9 - (lane * 7) % 56;
+      messages.push_back(pseudo_random_data(len, static_cast<uint32_t>(blocks * lanes + lane)));
+      padded.push_back(pad_message(messages.back(), big_endian));
+      REQUIRE(padded.back().size() == 64 * blocks);
+    }
+
+    const unsigned char *ptrs[lanes];
+    uint32_t state[Words * lanes];
+    for (size_t lane = 0; lane < lanes; ++lane)
+    {
+      ptrs[lane] = reinterpret_cast<const unsigned char *>(padded[lane].data());
+      for (size_t w = 0; w < Words; ++w) state[w * lanes + lane] = iv[w];
+    }
+    kernel(state, ptrs, blocks);
+
+    for (size_t lane = 0; lane < lanes; ++lane)
+    {
+      Digest result;
+      for (size_t w = 0; w < Words; ++w)
+      {
+        for (size_t b = 0; b < 4; ++b)
+        {
+          const uint32_t word = state[w * lanes + lane];
+          result[4 * w + b] = static_cast<uint8_t>(word >> (big_endian ? 24 - 8 * b : 8 * b));
+        }
+      }
+      REQUIRE(result == digest(messages[lane]));
+    }
+  }
+}
+#endif  // UTILS_X86_SIMD
+
+}  // namespace
+
+// ---------------- 标准测试向量 ----------------
+TEST_CASE("digest: FIPS 180 and RFC 1321 vectors", "[digest]")
+{
+  // FIPS 180 示例与 RFC 1321 测试集; 56 字节的消息需要两个填充块
+  const std::string abc = "abc";
+  const std::string two_blocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+
+  REQUIRE(digest_hex(sha256("")) == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  REQUIRE(digest_hex(sha256(abc)) == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  REQUIRE(digest_hex(sha256(two_blocks)) == "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+  REQUIRE(digest_hex(sha1("")) == "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+  REQUIRE(digest_hex(sha1(abc)) == "a9993e364706816aba3e25717850c26c9cd0d89d");
+  REQUIRE(digest_hex(sha1(two_blocks)) == "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+
+  REQUIRE(digest_hex(md5("")) == "d41d8cd98f00b204e9800998ecf8427e");
+  REQUIRE(digest_hex(md5(abc)) == "900150983cd24fb0d6963f7d28e17f72");
+  REQUIRE(digest_hex(md5("message digest")) == "f96b697d7cb7938d525a2f31aaf161d0");
+  REQUIRE(digest_hex(md5(std::string("1234567890") + "1234567890" + "1234567890" + "1234567890" + "1234567890" +
+                         "1234567890" + "1234567890" + "1234567890")) == "57edf4a22be3c955ac49da2e2107b67a");
+
+  const std::string million(1000000, 'a');
+  REQUIRE(digest_hex(sha256(million)) == "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+  REQUIRE(digest_hex(sha1(million)) == "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+  REQUIRE(digest_hex(md5(million)) == "7707d6ae4e027c70eea2a935c2296f21");
+}
+
+// ---------------- 增量计算 ----------------
+TEST_CASE("digest: incremental hashers match one-shot", "[digest][hasher]")
+{
+  // 覆盖缓冲区填满、跨块与一个 / 两个填充块的各种组合
+  for (size_t len = 0; len <= 200; ++len)
+  {
+    const std::string data = pseudo_random_data(len, static_cast<uint32_t>(len));
+    for (size_t step : {1, 7, 64, 100})
+    {
+      check_streaming<sha256_hasher>(data, step, sha256(data));
+      check_streaming<sha1_hasher>(data, step, sha1(data));
+      check_streaming<md5_hasher>(data, step, md5(data));
+    }
+  }
+
+  sha256_hasher hasher;
+  hasher.update("abc");
+  REQUIRE(hasher.value() == sha256("abc"));
+  hasher.update("def");  // value() 不影响继续计算
+  REQUIRE(hasher.value() == sha256("abcdef"));
+  hasher.reset();
+  REQUIRE(hasher.value() == sha256(""));
+}
+
+// ---------------- 多条消息 ----------------
+TEST_CASE("digest: multi-message API matches single messages", "[digest][many]")
+{
+  // 长短悬殊的消息, 使各 lane 在不同时刻换入新消息
+  std::vector<std::string> messages;
+  for (size_t i = 0; i < 70; ++i) messages.push_back(pseudo_random_data((i * 37) % 300, static_cast<uint32_t>(i)));
+  messages.push_back(pseudo_random_data(100000, 1));
+  messages.push_back(std::string());
+  messages.push_back(pseudo_random_data(5000, 2));
+
+  const std::vector<sha256_digest> d256 = sha256_many(messages);
+  const std::vector<sha1_digest> d1 = sha1_many(messages);
+  const std::vector<md5_digest> d5 = md5_many(messages);
+  REQUIRE(d256.size() == messages.size());
+  for (size_t i = 0; i < messages.size(); ++i)
+  {
+    REQUIRE(d256[i] == sha256(messages[i]));
+    REQUIRE(d1[i] == sha1(messages[i]));
+    REQUIRE(d5[i] == md5(messages[i]));
+  }
+
+  // 少于并行路数
+  const std::vector<std::string> few = {"abc", pseudo_random_data(1000, 3)};
+  REQUIRE(md5_many(few)[0] == md5("abc"));
+  REQUIRE(md5_many(few)[1] == md5(few[1]));
+  REQUIRE(sha256_many(std::vector<std::string>()).empty());
+}
+
+#if UTILS_X86_SIMD
+// 有 SHA-NI 时运行时分派不会选择 SHA 的多消息内核, 这里直接调用, 与逐条计算的结果比较
+TEST_CASE("digest: AVX2 multi-buffer kernels match single messages", "[digest][many][simd]")
+{
+  if (!cpu::features().avx2) return;
+
+  static const uint32_t sha256_iv[8] = {0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+                                        0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19};
+  static const uint32_t sha1_iv[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+  static const uint32_t md5_iv[4] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476};
+  check_multi_kernel(detail::sha256_x8_avx2, sha256_iv, true, sha256);
+  check_multi_kernel(detail::sha1_x8_avx2, sha1_iv, true, sha1);
+  check_multi_kernel(detail::md5_x8_avx2, md5_iv, false, md5);
+}
+#endif  // UTILS_X86_SIMD
+
+// ---------------- 文件 ----------------
+TEST_CASE("digest: file interfaces", "[digest][file]")
+{
+  const std::string data = pseudo_random_data(300000, 4);
+  const std::string path = write_temp_file(data);
+  REQUIRE(sha256_file(path) == sha256(data));
+  REQUIRE(sha1_file(path, 4096) == sha1(data));
+  REQUIRE(md5_file(path) == md5(data));
+  REQUIRE(sha256_file("/nonexistent/digest_test") == sha256_digest{});
+
+  std::vector<std::string> paths;
+  std::vector<std::string> contents;
+  for (size_t i = 0; i < 20; ++i)
+  {
+    contents.push_back(pseudo_random_data(i * 1000, static_cast<uint32_t>(i)));
+    paths.push_back(write_temp_file(contents.back()));
+  }
+  paths.push_back("/nonexistent/digest_test");
+
+  const std::vector<sha256_digest> d256 = sha256_files(paths);
+  const std::vector<md5_digest> d5 = md5_files(paths);
+  REQUIRE(d256.size() == paths.size());
+  for (size_t i = 0; i < contents.size(); ++i)
+  {
+    REQUIRE(d256[i] == sha256(contents[i]));
+    REQUIRE(d5[i] == md5(contents[i]));
+  }
+  REQUIRE(d256.back() == sha256_digest{});
+  REQUIRE(d5.back() == md5_digest{});
+}
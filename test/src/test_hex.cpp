@@ -0,0 +1,118 @@
+#include <catch2/catch.hpp>
+#include <string>
+
+#include "utils/hex.h"
+
+namespace
+{
+// 逐字节的参考实现
+std::string reference_hex(const std::string &data, bool uppercase)
+{
+  const char *digits = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+  std::string result;
+  for (unsigned char c : data)
+  {
+    result.push_back(digits[c >> 4]);
+    result.push_back(digits[c & 0x0F]);
+  }
+  return result;
+}
+
+std::string pattern_bytes(size_t len)
+{
+  std::string data(len, '\0');
+  for (size_t i = 0; i < len; ++i)
+  {
+    data[i] = static_cast<char>((i * 37 + 11) & 0xFF);
+  }
+  return data;
+}
+}  // namespace
+
+TEST_CASE("hex: known values", "[hex]")
+{
+  REQUIRE(codec::hex_encode(std::string()).empty());
+  REQUIRE(codec::hex_encode(std::string("\x01\xab\xff", 3)) == "01abff");
+  REQUIRE(codec::hex_encode(std::string("\x01\xab\xff", 3), true) == "01ABFF");
+  REQUIRE(codec::hex_decode("01abff") == std::string("\x01\xab\xff", 3));
+  REQUIRE(codec::hex_decode("01ABff") == std::string("\x01\xab\xff", 3));  // 大小写混合
+  REQUIRE(codec::hex_decode("").empty());
+
+  REQUIRE(codec::hex_digit(10) == 'a');
+  REQUIRE(codec::hex_digit(0x1F, true) == 'F');  // 只取低 4 bit
+  REQUIRE(codec::hex_value('7') == 7);
+  REQUIRE(codec::hex_value('c') == 12);
+  REQUIRE(codec::hex_value('C') == 12);
+  REQUIRE(codec::hex_value('g') == -1);
+}
+
+TEST_CASE("hex: round trip for all lengths", "[hex]")
+{
+  // 覆盖 SIMD 块 (16/32 字节) 与标量尾部的各种组合
+  for (size_t len = 0; len <= 200; ++len)
+  {
+    const std::string data = pattern_bytes(len);
+    const std::string lower = codec::hex_encode(data);
+    const std::string upper = codec::hex_encode(data, true);
+    REQUIRE(lower == reference_hex(data, false));
+    REQUIRE(upper == reference_hex(data, true));
+    REQUIRE(codec::hex_decode(lower) == data);
+    REQUIRE(codec::hex_decode(upper) == data);
+  }
+
+  // 所有字节值
+  std::string all;
+  for (int i = 0; i < 256; ++i) all.push_back(static_cast<char>(i));
+  REQUIRE(codec::hex_decode(codec::hex_encode(all)) == all);
+}
+
+TEST_CASE("hex: invalid input reports the offending offset", "[hex]")
+{
+  // 在不同位置 (SIMD 块内与尾部) 放入非法字符
+  const std::string valid = codec::hex_encode(pattern_bytes(100));
+  for (size_t pos : {size_t(0), size_t(1), size_t(17), size_t(40), size_t(63), size_t(64), size_t(130), size_t(199)})
+  {
+    for (char bad : {'g', 'G', '/', ':', '@', '`', ' ', '\x80'})
+    {
+      std::string s = valid;
+      s[pos] = bad;
+      try
+      {
+        codec::hex_decode(s);
+        FAIL("expected hex_error");
+      }
+      catch (const codec::hex_error &e)
+      {
+        REQUIRE(e.position() == pos);
+      }
+    }
+  }
+
+  // 奇数长度: 最后一个字符不成对
+  try
+  {
+    codec::hex_decode(valid.substr(0, 99));
+    FAIL("expected hex_error");
+  }
+  catch (const codec::hex_error &e)
+  {
+    REQUIRE(e.position() == 98);
+  }
+  REQUIRE_THROWS_AS(codec::hex_decode("a"), codec::hex_error);
+}
+
+TEST_CASE("hex: caller buffer variants", "[hex]")
+{
+  const std::string data = pattern_bytes(40);
+  const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data.data());
+
+  char out[80];
+  REQUIRE(codec::hex_encode_to(bytes, data.size(), out, sizeof(out), true) == 80);
+  REQUIRE(std::string(out, 80) == reference_hex(data, true));
+  REQUIRE_THROWS_AS(codec::hex_encode_to(bytes, data.size(), out, 79), std::length_error);
+
+  unsigned char decoded[40];
+  REQUIRE(codec::hex_decode_to(out, 80, decoded, sizeof(decoded)) == 40);
+  REQUIRE(std::string(reinterpret_cast<char *>(decoded), 40) == data);
+  REQUIRE_THROWS_AS(codec::hex_decode_to(out, 80, decoded, 39), std::length_error);
+}
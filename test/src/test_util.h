@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+//
+// 各测试文件共用的辅助函数: 确定性的伪随机数据、参考 CRC 与临时文件
+//
+
+#ifndef __GUARD_TEST_UTIL_H_INCLUDE_GUARD__
+#define __GUARD_TEST_UTIL_H_INCLUDE_GUARD__
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+namespace testutil
+{
+
+// 确定性的伪随机数据 (线性同余); 每个字节取状态的第 shift ~ shift+7 位
+inline std::string pseudo_random_data(size_t len, uint32_t seed, unsigned int shift = 24)
+{
+  std::string data(len, '\0');
+  for (size_t i = 0; i < len; ++i)
+  {
+    seed = seed * 1103515245U + 12345U;
+    data[i] = static_cast<char>(seed >> shift);
+  }
+  return data;
+}
+
+// 按 Rocksoft 模型逐位计算的参考实现
+inline uint64_t reference_crc(unsigned int width, uint64_t poly, uint64_t init, bool refin, bool refout,
+                              uint64_t xorout, const std::string &data)
+{
+  const uint64_t top = uint64_t(1) << (width - 1);
+  const uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+
+  uint64_t reg = init & mask;
+  for (unsigned char c : data)
+  {
+    // 每次送入一位: refin 时从字节的最低位开始
+    for (unsigned int k = 0; k < 8; ++k)
+    {
+      const unsigned int i = refin ? k : 7 - k;
+      reg ^= static_cast<uint64_t>((c >> i) & 1) << (width - 1);
+      reg = ((reg & top) != 0 ? (reg << 1) ^ poly : reg << 1) & mask;
+    }
+  }
+  if (refout)
+  {
+    uint64_t reflected = 0;
+    for (unsigned int i = 0; i < width; ++i) reflected = (reflected << 1) | ((reg >> i) & 1);
+    reg = reflected;
+  }
+  return (reg ^ xorout) & mask;
+}
+
+// 临时目录下的测试文件路径; name 可以包含不存在的子目录, 用于测试打开失败
+inline std::string temp_path(const std::string &name)
+{
+#ifdef _WIN32
+  char *tmp_dir_buf = nullptr;
+  size_t len = 0;
+  errno_t err = _dupenv_s(&tmp_dir_buf, &len, "TMP");
+  if (err != 0 || (tmp_dir_buf == nullptr))
+  {
+    err = _dupenv_s(&tmp_dir_buf, &len, "TEMP");
+    REQUIRE(tmp_dir_buf != nullptr);
+  }
+  const std::string path = std::string(tmp_dir_buf) + "\\utils_test_" + name;
+  free(tmp_dir_buf);
+  return path;
+#else
+  return "/tmp/utils_test_" + name;
+#endif
+}
+
+// 写入一个新的临时文件, 返回其路径
+inline std::string write_temp_file(const std::string &content)
+{
+  static int idx = 0;
+  const std::string path = temp_path(std::to_string(idx++));
+  std::ofstream ofs(path, std::ios::binary);
+  REQUIRE(ofs.good());
+  ofs.write(content.data(), content.size());
+  return path;
+}
+
+}  // namespace testutil
+
+#endif  // __GUARD_TEST_UTIL_H_INCLUDE_GUARD__
@@ -6,7 +6,10 @@
 #ifndef BASE64_H_C0CE2A47_D10E_42C9_A27C_C883944E704A
 #define BASE64_H_C0CE2A47_D10E_42C9_A27C_C883944E704A
 
+#include <cstddef>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #if __cplusplus >= 201703L
 #include <string_view>
@@ -14,13 +17,228 @@
 
 namespace codec
 {
+//
+// Thrown by the decoding functions when the input is not valid
+// base64-encoded data. position() is the offset of the first
+// offending character (or of an incomplete last group).
+//
+class base64_error : public std::runtime_error
+{
+  public:
+    explicit base64_error(size_t position);
+
+    size_t position() const noexcept
+    {
+        return position_;
+    }
+
+  private:
+    size_t position_;
+};
+
+//
+// Characters the decoder skips wherever they occur, e.g. the line breaks
+// of PEM/MIME encoded data. base64_decode(s, true) is the same as
+// base64_decode(s, base64_skip::linebreaks).
+//
+enum class base64_skip : unsigned int
+{
+    none = 0,
+    lf = 1,
+    cr = 2,
+    space = 4,
+    tab = 8,
+    linebreaks = lf | cr,
+    whitespace = lf | cr | space | tab
+};
+
+constexpr base64_skip operator|(base64_skip a, base64_skip b)
+{
+    return static_cast<base64_skip>(static_cast<unsigned int>(a) | static_cast<unsigned int>(b));
+}
+
 std::string base64_encode(std::string const& s, bool url = false);
-std::string base64_encode_pem(std::string const& s);
-std::string base64_encode_mime(std::string const& s);
+std::string base64_encode_pem(std::string const& s, bool crlf = false);
+std::string base64_encode_mime(std::string const& s, bool crlf = false);
 
 std::string base64_decode(std::string const& s, bool remove_linebreaks = false);
+std::string base64_decode(std::string const& s, base64_skip skip);
 std::string base64_encode(unsigned char const*, size_t len, bool url = false);
 
+//
+// Interface without allocations: the *_to functions write into a buffer
+// provided by the caller (or append to a std::string whose capacity can be
+// reused) and return the number of bytes written.
+//
+// base64_encoded_size() is the exact length of the encoding of len bytes,
+// base64_decoded_size() an upper bound for the decoding of encoded_len
+// characters. The char* overloads throw std::length_error if out_capacity
+// is too small, the decode functions throw base64_error on invalid input.
+//
+size_t base64_encoded_size(size_t len);
+size_t base64_decoded_size(size_t encoded_len);
+
+size_t base64_encode_to(unsigned char const*, size_t len, char* out, size_t out_capacity, bool url = false);
+size_t base64_encode_to(unsigned char const*, size_t len, std::string& out, bool url = false);
+size_t base64_encode_to(std::string const& s, std::string& out, bool url = false);
+
+size_t base64_decode_to(char const* encoded, size_t len, char* out, size_t out_capacity,
+                        base64_skip skip = base64_skip::none);
+size_t base64_decode_to(char const* encoded, size_t len, std::string& out, base64_skip skip = base64_skip::none);
+size_t base64_decode_to(std::string const& s, std::string& out, base64_skip skip = base64_skip::none);
+
+//
+// Checking input without decoding it: base64_validate() accepts exactly
+// the input the decode functions accept, without allocating or throwing.
+// On invalid input *error_pos (if given) is set to the offset that
+// base64_error::position() would report, otherwise to size_t(-1).
+// base64_decoded_length() is the exact length of the decoding of valid
+// input, taking padding ('=' or '.') and skipped characters into account.
+//
+bool base64_validate(char const* encoded, size_t len, base64_skip skip = base64_skip::none,
+                     size_t* error_pos = nullptr) noexcept;
+bool base64_validate(std::string const& s, base64_skip skip = base64_skip::none, size_t* error_pos = nullptr) noexcept;
+
+size_t base64_decoded_length(char const* encoded, size_t len, base64_skip skip = base64_skip::none) noexcept;
+size_t base64_decoded_length(std::string const& s, base64_skip skip = base64_skip::none) noexcept;
+
+//
+// Decoding in place: the decoded bytes overwrite buf from the front, and
+// the decoded length is returned (base64_decode_inplace(std::string&)
+// shrinks the string to it). Throws base64_error on invalid input, buf
+// is partially overwritten then.
+//
+size_t base64_decode_inplace(char* buf, size_t len, base64_skip skip = base64_skip::none);
+size_t base64_decode_inplace(std::string& s, base64_skip skip = base64_skip::none);
+
+//
+// Encoding with a line break ("\n", or "\r\n" if crlf) after every
+// line_length characters, written in a single pass. There is no line
+// break after the last line. base64_encode_pem() and base64_encode_mime()
+// use a line length of 64 and 76. A line_length of 0 disables wrapping.
+//
+size_t base64_encoded_size(size_t len, size_t line_length, bool crlf = false);
+
+std::string base64_encode_wrapped(unsigned char const*, size_t len, size_t line_length, bool crlf = false);
+std::string base64_encode_wrapped(std::string const& s, size_t line_length, bool crlf = false);
+size_t base64_encode_wrapped_to(unsigned char const*, size_t len, char* out, size_t out_capacity, size_t line_length,
+                                bool crlf = false);
+
+//
+// Incremental encoding of data that arrives in pieces of any size, e.g.
+// from a socket or a file, with bounded memory. update() appends the
+// encoding of all complete 3-byte groups to out and keeps the 0-2
+// remaining bytes for the next call, finish() appends the last (padded)
+// group and resets the encoder. The result is the same as base64_encode()
+// of the concatenated input, or base64_encode_wrapped() with a line_length
+// other than 0.
+//
+class base64_encoder
+{
+  public:
+    explicit base64_encoder(bool url = false, size_t line_length = 0, bool crlf = false);
+
+    size_t update(void const* data, size_t len, std::string& out);
+    size_t finish(std::string& out);
+
+    std::string update(std::string const& s);
+    std::string finish();
+
+    void reset();
+
+  private:
+    bool url_;
+    bool crlf_;
+    size_t line_length_;
+    size_t column_;
+    unsigned char pending_[3];
+    size_t pending_len_;
+};
+
+//
+// Incremental decoding, the counterpart of base64_encoder. update()
+// appends the decoding of all complete chunks of 4 characters to out and
+// keeps the 0-3 remaining characters (skipped characters not counted) for
+// the next call, finish() decodes the last chunk and resets the decoder.
+// base64_error::position() is the offset in the concatenated input. After
+// an error the decoder has to be reset().
+//
+class base64_decoder
+{
+  public:
+    explicit base64_decoder(base64_skip skip = base64_skip::none);
+
+    size_t update(char const* encoded, size_t len, std::string& out);
+    size_t finish(std::string& out);
+
+    std::string update(std::string const& s);
+    std::string finish();
+
+    void reset();
+
+  private:
+    unsigned int skip_;
+    char pending_[3];
+    size_t pending_pos_[3];
+    size_t pending_len_;
+    size_t offset_;
+};
+
+//
+// Encoding of many (short) values at once: all encodings are written back
+// to back into out, the encoding of inputs[i] is out[offsets[i],
+// offsets[i + 1]). out and offsets are replaced (their capacity is
+// reused), the total length is returned. The inputs are packed into
+// blocks that are encoded in one vectorized pass each, which avoids the
+// per-call overhead of base64_encode() for values of a few dozen bytes.
+//
+struct base64_input
+{
+    unsigned char const* data;
+    size_t len;
+};
+
+size_t base64_encode_batch(base64_input const* inputs, size_t count, std::string& out, std::vector<size_t>& offsets,
+                           bool url = false);
+size_t base64_encode_batch(std::string const* inputs, size_t count, std::string& out, std::vector<size_t>& offsets,
+                           bool url = false);
+
+//
+// Encoding and decoding on several threads for large inputs. The input is
+// split at 3-byte (encode) or 4-character (decode) boundaries and every
+// thread writes its part directly into the preallocated result. threads
+// is the number of threads to use, 0 for std::thread::hardware_concurrency().
+// Inputs smaller than threshold bytes are processed on the calling thread.
+// The results are the same as those of base64_encode() and base64_decode();
+// input with padding in the middle (concatenated encodings) is decoded on
+// the calling thread.
+//
+const size_t base64_parallel_threshold = 4 * 1024 * 1024;
+
+std::string base64_encode_parallel(unsigned char const*, size_t len, bool url = false, unsigned int threads = 0,
+                                   size_t threshold = base64_parallel_threshold);
+std::string base64_encode_parallel(std::string const& s, bool url = false, unsigned int threads = 0,
+                                   size_t threshold = base64_parallel_threshold);
+
+std::string base64_decode_parallel(char const* encoded, size_t len, unsigned int threads = 0,
+                                   size_t threshold = base64_parallel_threshold);
+std::string base64_decode_parallel(std::string const& s, unsigned int threads = 0,
+                                   size_t threshold = base64_parallel_threshold);
+
+//
+// Encoding and decoding from file to file with constant memory: the input
+// is memory-mapped where possible and the output is written in large
+// blocks. base64_encode_file() wraps lines like base64_encode_wrapped()
+// (not at all for a line_length of 0), base64_decode_file() skips the
+// characters selected by skip. Both return false if a file cannot be
+// opened, read or written, base64_decode_file() throws base64_error on
+// invalid input. The output file is incomplete in both cases.
+//
+bool base64_encode_file(std::string const& in_path, std::string const& out_path, size_t line_length = 0,
+                        bool crlf = false, bool url = false);
+bool base64_decode_file(std::string const& in_path, std::string const& out_path,
+                        base64_skip skip = base64_skip::whitespace);
+
 #if __cplusplus >= 201703L
 //
 // Interface with std::string_view rather than const std::string&
@@ -28,10 +246,11 @@ std::string base64_encode(unsigned char const*, size_t len, bool url = false);
 // Provided by Yannic Bonenberger (https://github.com/Yannic)
 //
 std::string base64_encode(std::string_view s, bool url = false);
-std::string base64_encode_pem(std::string_view s);
-std::string base64_encode_mime(std::string_view s);
+std::string base64_encode_pem(std::string_view s, bool crlf = false);
+std::string base64_encode_mime(std::string_view s, bool crlf = false);
 
 std::string base64_decode(std::string_view s, bool remove_linebreaks = false);
+std::string base64_decode(std::string_view s, base64_skip skip);
 #endif  // __cplusplus >= 201703L
 }  // namespace codec
 
@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file base64_constexpr.h
+ * @brief 编译期 base64 编解码（用于嵌入程序的常量: 测试密钥、默认令牌、协议魔数等）
+ *
+ * 只使用 C++11 constexpr (单条 return 语句), 在 C++11/14/17 下均可用:
+ *
+ *   constexpr auto token = codec::base64_encode_literal("user:pass");          // std::array<char, 12>
+ *   constexpr auto magic = UTILS_BASE64_DECODE("TVV0aWxz");                   // std::array<unsigned char, 6>
+ *   constexpr auto key = codec::base64_decode_literal<4>("3q2+7w==");        // 显式给出解码长度
+ *
+ * 解码规则与 base64_decode() 相同 (接受 '+' '-' / '/' '_', 填充 '=' 或 '.' 可省略),
+ * 但不允许空白和中间的填充 (拼接的编码). 非法输入在常量表达式中求值时产生编译错误,
+ * 运行期求值时抛出 base64_error (长度不符时抛出 std::length_error).
+ * 结果不含结尾的 '\0'.
+ *
+ * @author abin
+ * @date 2025-12-10
+ */
+
+#ifndef __GUARD_BASE64_CONSTEXPR_H_INCLUDE_GUARD__
+#define __GUARD_BASE64_CONSTEXPR_H_INCLUDE_GUARD__
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+
+#include "utils/base64.h"
+#include "utils/detail/index_seq.h"
+
+namespace codec
+{
+namespace literal_detail
+{
+
+using utils_detail::index_seq;
+using utils_detail::make_seq;
+
+// ---------------- 编码 ----------------
+constexpr unsigned int byte_at(const char *s, size_t len, size_t i)
+{
+  return i < len ? static_cast<unsigned char>(s[i]) : 0U;
+}
+
+constexpr char alphabet(unsigned int v, bool url)
+{
+  return v < 26 ? static_cast<char>('A' + v)
+         : v < 52 ? static_cast<char>('a' + v - 26)
+         : v < 62 ? static_cast<char>('0' + v - 52)
+         : v == 62 ? (url ? '-' : '+')
+                   : (url ? '_' : '/');
+}
+
+// 24 bit 组 triple 中第 pos 个 6 bit 值
+constexpr unsigned int sextet(unsigned int triple, size_t pos)
+{
+  return (triple >> (18 - 6 * pos)) & 0x3f;
+}
+
+constexpr char encoded_char(const char *s, size_t len, size_t k, bool url)
+{
+  return (k % 4 == 2 && k / 4 * 3 + 1 >= len) || (k % 4 == 3 && k / 4 * 3 + 2 >= len)
+           ? (url ? '.' : '=')
+           : alphabet(sextet((byte_at(s, len, k / 4 * 3) << 16) | (byte_at(s, len, k / 4 * 3 + 1) << 8) |
+                               byte_at(s, len, k / 4 * 3 + 2),
+                             k % 4),
+                      url);
+}
+
+template <size_t N, size_t... K>
+constexpr std::array<char, sizeof...(K)> encode(const char (&s)[N], bool url, index_seq<K...>)
+{
+  // 空字面量时 K 为空包, (void)url 避免未使用参数的警告
+  return (void)url, std::array<char, sizeof...(K)>{{encoded_char(s, N - 1, K, url)...}};
+}
+
+// ---------------- 解码 ----------------
+constexpr bool is_padding(char c)
+{
+  return c == '=' || c == '.';
+}
+
+// 6 bit 值; 非 base64 字符 (含位置不对的填充) 抛出 base64_error
+constexpr unsigned int value(char c, size_t pos)
+{
+  return c >= 'A' && c <= 'Z'   ? static_cast<unsigned int>(c - 'A')
+         : c >= 'a' && c <= 'z' ? static_cast<unsigned int>(c - 'a' + 26)
+         : c >= '0' && c <= '9' ? static_cast<unsigned int>(c - '0' + 52)
+         : c == '+' || c == '-' ? 62U
+         : c == '/' || c == '_' ? 63U
+                                : throw base64_error(pos);
+}
+
+// 去掉结尾填充后的字符数: 填充最多两个, 且只能在 4 字符块的第 3、4 位
+constexpr size_t data_length(const char *s, size_t len)
+{
+  return len >= 1 && (len - 1) % 4 == 3 && is_padding(s[len - 1])
+           ? (is_padding(s[len - 2]) ? len - 2 : len - 1)
+         : len >= 1 && (len - 1) % 4 == 2 && is_padding(s[len - 1]) ? len - 1
+                                                                      : len;
+}
+
+constexpr size_t decoded_length(size_t n)
+{
+  // 单独剩下 1 个字符的块不能构成一个字节
+  return n % 4 == 1 ? throw base64_error(n - 1) : n / 4 * 3 + n % 4 * 3 / 4;
+}
+
+// 第 k 个输出字节由第 k / 3 块中相邻的两个字符组成
+constexpr unsigned char decoded_byte(const char *s, size_t k)
+{
+  return static_cast<unsigned char>(
+    ((value(s[k / 3 * 4 + k % 3], k / 3 * 4 + k % 3) << (2 + 2 * (k % 3))) |
+     (value(s[k / 3 * 4 + k % 3 + 1], k / 3 * 4 + k % 3 + 1) >> (4 - 2 * (k % 3)))) &
+    0xff);
+}
+
+template <size_t N, size_t... K>
+constexpr std::array<unsigned char, sizeof...(K)> decode(const char (&s)[N], index_seq<K...>)
+{
+  return std::array<unsigned char, sizeof...(K)>{{decoded_byte(s, K)...}};
+}
+
+}  // namespace literal_detail
+
+// 字面量 s (不含结尾 '\0') 的编码
+template <size_t N>
+constexpr std::array<char, (N + 1) / 3 * 4> base64_encode_literal(const char (&s)[N], bool url = false)
+{
+  return literal_detail::encode(s, url, typename literal_detail::make_seq<(N + 1) / 3 * 4>::type());
+}
+
+// 字面量 s 解码后的长度, 非法的结尾 (单个剩余字符) 同样报错
+template <size_t N>
+constexpr size_t base64_literal_decoded_length(const char (&s)[N])
+{
+  return literal_detail::decoded_length(literal_detail::data_length(s, N - 1));
+}
+
+// 解码字面量 s, M 必须等于 base64_literal_decoded_length(s)
+template <size_t M, size_t N>
+constexpr std::array<unsigned char, M> base64_decode_literal(const char (&s)[N])
+{
+  return base64_literal_decoded_length(s) != M
+           ? throw std::length_error("base64_decode_literal: wrong decoded length")
+           : literal_detail::decode(s, typename literal_detail::make_seq<M>::type());
+}
+
+}  // namespace codec
+
+// 解码字面量并自动推导结果长度
+#define UTILS_BASE64_DECODE(literal) \
+  ::codec::base64_decode_literal< ::codec::base64_literal_decoded_length(literal)>(literal)
+
+#endif  // __GUARD_BASE64_CONSTEXPR_H_INCLUDE_GUARD__
@@ -11,43 +11,581 @@
 #ifndef __GUARD_CHECK_H_INCLUDE_GUARD__
 #define __GUARD_CHECK_H_INCLUDE_GUARD__
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
 namespace checkutils
 {
 
+// *_file: 普通文件经内存映射直接计算, 管道和设备文件按 buffer_size 字节 (0 为 1 MiB) 的块读取;
+// 文件无法打开或读取出错时返回 0
+
 // ---------------- CRC ----------------
 uint8_t crc8(const std::string &data);
-uint8_t crc8_file(const std::string &filepath);
+uint8_t crc8_file(const std::string &filepath, size_t buffer_size = 0);
 
 uint16_t crc16(const std::string &data); // CRC-16-modbus
-uint16_t crc16_file(const std::string &filepath);
+uint16_t crc16_file(const std::string &filepath, size_t buffer_size = 0);
 
 uint32_t crc32(const std::string &data);
-uint32_t crc32_file(const std::string &filepath);
+uint32_t crc32_file(const std::string &filepath, size_t buffer_size = 0);
+
+uint32_t crc32c(const std::string &data);  // CRC-32C (Castagnoli), iSCSI/ext4/SCTP 使用
+uint32_t crc32c_file(const std::string &filepath, size_t buffer_size = 0);
+
+uint64_t crc64(const std::string &data);  // CRC-64/XZ, xz 与 Go hash/crc64 (ECMA 表) 使用
+uint64_t crc64_file(const std::string &filepath, size_t buffer_size = 0);
+
+uint64_t crc64_ecma(const std::string &data);  // CRC-64/ECMA-182: 同一多项式, 非反射, 初值与结果异或值为 0
+uint64_t crc64_ecma_file(const std::string &filepath, size_t buffer_size = 0);
+
+// 合并相邻两段数据的 CRC: crc1 为前一段的 CRC, crc2 为长度 len2 的后一段的 CRC,
+// 返回两段拼接后的 CRC
+uint32_t crc32_combine(uint32_t crc1, uint32_t crc2, uint64_t len2);
+uint32_t crc32c_combine(uint32_t crc1, uint32_t crc2, uint64_t len2);
+
+// 多线程计算文件的 CRC: 文件按范围切分, 各线程分别计算后合并, 结果与 crc32_file() 相同.
+// threads 为 0 时使用 std::thread::hardware_concurrency(), 小于 threshold 字节的文件在调用线程上计算
+const uint64_t parallel_file_threshold = 64 * 1024 * 1024;
+
+uint32_t crc32_file_parallel(const std::string &filepath, unsigned int threads = 0,
+                             uint64_t threshold = parallel_file_threshold);
+uint32_t crc32c_file_parallel(const std::string &filepath, unsigned int threads = 0,
+                              uint64_t threshold = parallel_file_threshold);
+
+// ---------------- 非加密哈希 (xxHash) ----------------
+// 结果与 xxHash 参考实现的 XXH64(), XXH3_64bits_withSeed(), XXH3_128bits_withSeed() 相同.
+// 分布均匀且速度快, 用于哈希表、分片、去重等; 不能抵御刻意构造的碰撞
+struct hash128
+{
+  uint64_t low;
+  uint64_t high;
+};
+
+inline bool operator==(const hash128 &a, const hash128 &b)
+{
+  return a.low == b.low && a.high == b.high;
+}
+inline bool operator!=(const hash128 &a, const hash128 &b)
+{
+  return !(a == b);
+}
+
+uint64_t xxh64(const std::string &data, uint64_t seed = 0);
+uint64_t xxh64_file(const std::string &filepath, uint64_t seed = 0, size_t buffer_size = 0);
+
+uint64_t xxh3_64(const std::string &data, uint64_t seed = 0);
+uint64_t xxh3_64_file(const std::string &filepath, uint64_t seed = 0, size_t buffer_size = 0);
+
+hash128 xxh3_128(const std::string &data, uint64_t seed = 0);
+hash128 xxh3_128_file(const std::string &filepath, uint64_t seed = 0, size_t buffer_size = 0);
 
 // ---------------- 和校验 ----------------
 uint8_t sum8(const std::string &data);  // 1字节和校验
-uint8_t sum8_file(const std::string &filepath);
+uint8_t sum8_file(const std::string &filepath, size_t buffer_size = 0);
 
 uint16_t sum16(const std::string &data);  // 2字节和校验
-uint16_t sum16_file(const std::string &filepath);
+uint16_t sum16_file(const std::string &filepath, size_t buffer_size = 0);
 
 // ---------------- 异或校验 ----------------
 uint8_t xor8(const std::string &data);
-uint8_t xor8_file(const std::string &filepath);
+uint8_t xor8_file(const std::string &filepath, size_t buffer_size = 0);
 
 // ---------------- LRC（纵向冗余校验） ----------------
 uint8_t lrc8(const std::string &data);
-uint8_t lrc8_file(const std::string &filepath);
+uint8_t lrc8_file(const std::string &filepath, size_t buffer_size = 0);
 
 // ---------------- Fletcher 校验 ----------------
 uint16_t fletcher16(const std::string &data);
-uint16_t fletcher16_file(const std::string &filepath);
+uint16_t fletcher16_file(const std::string &filepath, size_t buffer_size = 0);
 
 uint32_t fletcher32(const std::string &data);
-uint32_t fletcher32_file(const std::string &filepath);
+uint32_t fletcher32_file(const std::string &filepath, size_t buffer_size = 0);
+
+// ---------------- Adler-32 ----------------
+uint32_t adler32(const std::string &data);  // 与 zlib 的 adler32() 相同
+uint32_t adler32_file(const std::string &filepath, size_t buffer_size = 0);
+
+// ---------------- 增量计算 ----------------
+// 数据分段到达时 (网络流、分块上传等) 逐段 update(), 随时可以用 value() 取得当前结果,
+// 结果与对拼接后的数据调用对应函数相同. reset() 回到初始状态.
+
+class crc8_hasher
+{
+ public:
+  void update(const void *data, size_t len);
+  void update(const std::string &data)
+  {
+    update(data.data(), data.size());
+  }
+  uint8_t value() const noexcept
+  {
+    return crc_;
+  }
+  void reset() noexcept
+  {
+    crc_ = 0x00;
+  }
+
+ private:
+  uint8_t crc_ = 0x00;
+};
+
+class crc16_hasher
+{
+ public:
+  void update(const void *data, size_t len);
+  void update(const std::string &data)
+  {
+    update(data.data(), data.size());
+  }
+  uint16_t value() const noexcept
+  {
+    return crc_;
+  }
+  void reset() noexcept
+  {
+    crc_ = 0xFFFF;
+  }
+
+ private:
+  uint16_t crc_ = 0xFFFF;
+};
+
+class crc32_hasher
+{
+ public:
+  void update(const void *data, size_t len);
+  void update(const std::string &data)
+  {
+    update(data.data(), data.size());
+  }
+  uint32_t value() const noexcept
+  {
+    return crc_;
+  }
+  void reset() noexcept
+  {
+    crc_ = 0;
+  }
+
+ private:
+  uint32_t crc_ = 0;
+};
+
+class crc32c_hasher
+{
+ public:
+  void update(const void *data, size_t len);
+  void update(const std::string &data)
+  {
+    update(data.data(), data.size());
+  }
+  uint32_t value() const noexcept
+  {
+    return crc_;
+  }
+  void reset() noexcept
+  {
+    crc_ = 0;
+  }
+
+ private:
+  uint32_t crc_ = 0;
+};
+
+class crc64_hasher
+{
+ public:
+  void update(const void *data, size_t len);
+  void update(const std::string &data)
+  {
+    update(data.data(), data.size());
+  }
+  uint64_t value() const noexcept
+  {
+    return crc_;
+  }
+  void reset() noexcept
+  {
+    crc_ = 0;
+  }
+
+ private:
+  uint64_t crc_ = 0;
+};
+
+class crc64_ecma_hasher
+{
+ public:
+  void update(const void *data, size_t len);
+  void update(const std::string &data)
+  {
+    update(data.data(), data.size());
+  }
+  uint64_t value() const noexcept
+  {
+    return crc_;
+  }
+  void reset() noexcept
+  {
+    crc_ = 0;
+  }
+
+ private:
+  uint64_t crc_ = 0;
+};
+
+class xxh64_hasher
+{
+ public:
+  explicit xxh64_hasher(uint64_t seed = 0) noexcept;
+
+  void update(const void *data, size_t len);
+  void update(const std::string &data)
+  {
+    update(data.data(), data.size());
+  }
+  uint64_t value() const noexcept;
+  void reset() noexcept;
+
+ private:
+  uint64_t seed_;
+  uint64_t v_[4];
+  uint64_t total_len_;
+  unsigned char buffer_[32];
+  size_t buffered_;
+};
+
+namespace detail
+{
+// XXH3 64/128 bit 共用的流式状态: 累加器、由种子导出的密钥, 以及最后不足一块的输入
+class xxh3_state
+{
+ public:
+  explicit xxh3_state(uint64_t seed) noexcept;
+
+  void update(const unsigned char *data, size_t len);
+  uint64_t digest64() const noexcept;
+  hash128 digest128() const noexcept;
+  void reset() noexcept;
+
+ private:
+  void digest_long(uint64_t *acc) const noexcept;
+
+  uint64_t seed_;
+  uint64_t acc_[8];
+  unsigned char secret_[192];
+  unsigned char buffer_[256];
+  size_t buffered_;
+  size_t stripes_;  // 当前块内已累加的 stripe 数
+  uint64_t total_len_;
+};
+}  // namespace detail
+
+class xxh3_64_hasher
+{
+ public:
+  explicit xxh3_64_hasher(uint64_t seed = 0) noexcept :
+    state_(seed)
+  {
+  }
+
+  void update(const void *data, size_t len)
+  {
+    state_.update(static_cast<const unsigned char *>(data), len);
+  }
+  void update(const std::string &data)
+  {
+    update(data.data(), data.size());
+  }
+  uint64_t value() const noexcept
+  {
+    return state_.digest64();
+  }
+  void reset() noexcept
+  {
+    state_.reset();
+  }
+
+ private:
+  detail::xxh3_state state_;
+};
+
+class xxh3_128_hasher
+{
+ public:
+  explicit xxh3_128_hasher(uint64_t seed = 0) noexcept :
+    state_(seed)
+  {
+  }
+
+  void update(const void *data, size_t len)
+  {
+    state_.update(static_cast<const unsigned char *>(data), len);
+  }
+  void update(const std::string &data)
+  {
+    update(data.data(), data.size());
+  }
+  hash128 value() const noexcept
+  {
+    return state_.digest128();
+  }
+  void reset() noexcept
+  {
+    state_.reset();
+  }
+
+ private:
+  detail::xxh3_state state_;
+};
+
+class sum8_hasher
+{
+ public:
+  void update(const void *data, size_t len);
+  void update(const std::string &data)
+  {
+    update(data.data(), data.size());
+  }
+  uint8_t value() const noexcept
+  {
+    return sum_;
+  }
+  void reset() noexcept
+  {
+    sum_ = 0;
+  }
+
+ private:
+  uint8_t sum_ = 0;
+};
+
+class sum16_hasher
+{
+ public:
+  void update(const void *data, size_t len);
+  void update(const std::string &data)
+  {
+    update(data.data(), data.size());
+  }
+  uint16_t value() const noexcept
+  {
+    return sum_;
+  }
+  void reset() noexcept
+  {
+    sum_ = 0;
+  }
+
+ private:
+  uint16_t sum_ = 0;
+};
+
+class xor8_hasher
+{
+ public:
+  void update(const void *data, size_t len);
+  void update(const std::string &data)
+  {
+    update(data.data(), data.size());
+  }
+  uint8_t value() const noexcept
+  {
+    return val_;
+  }
+  void reset() noexcept
+  {
+    val_ = 0;
+  }
+
+ private:
+  uint8_t val_ = 0;
+};
+
+class lrc8_hasher
+{
+ public:
+  void update(const void *data, size_t len);
+  void update(const std::string &data)
+  {
+    update(data.data(), data.size());
+  }
+  uint8_t value() const noexcept
+  {
+    return static_cast<uint8_t>(-sum_);
+  }
+  void reset() noexcept
+  {
+    sum_ = 0;
+  }
+
+ private:
+  uint8_t sum_ = 0;
+};
+
+class fletcher16_hasher
+{
+ public:
+  void update(const void *data, size_t len);
+  void update(const std::string &data)
+  {
+    update(data.data(), data.size());
+  }
+  uint16_t value() const noexcept
+  {
+    return static_cast<uint16_t>((sum2_ << 8) | sum1_);
+  }
+  void reset() noexcept
+  {
+    sum1_ = 0;
+    sum2_ = 0;
+  }
+
+ private:
+  uint16_t sum1_ = 0;
+  uint16_t sum2_ = 0;
+};
+
+class fletcher32_hasher
+{
+ public:
+  void update(const void *data, size_t len);
+  void update(const std::string &data)
+  {
+    update(data.data(), data.size());
+  }
+  uint32_t value() const noexcept
+  {
+    return (sum2_ << 16) | sum1_;
+  }
+  void reset() noexcept
+  {
+    sum1_ = 0;
+    sum2_ = 0;
+  }
+
+ private:
+  uint32_t sum1_ = 0;
+  uint32_t sum2_ = 0;
+};
+
+class adler32_hasher
+{
+ public:
+  void update(const void *data, size_t len);
+  void update(const std::string &data)
+  {
+    update(data.data(), data.size());
+  }
+  uint32_t value() const noexcept
+  {
+    return (b_ << 16) | a_;
+  }
+  void reset() noexcept
+  {
+    a_ = 1;
+    b_ = 0;
+  }
+
+ private:
+  uint32_t a_ = 1;
+  uint32_t b_ = 0;
+};
+
+// ---------------- 一次读取计算多种校验 ----------------
+// 选择要计算的校验 (可按位或组合), 结果放在 checksums 的对应字段中, 未选择的字段为 0; xxHash 的种子为 0
+enum class checksum : unsigned int
+{
+  crc8 = 1 << 0,
+  crc16 = 1 << 1,
+  crc32 = 1 << 2,
+  crc32c = 1 << 3,
+  sum8 = 1 << 4,
+  sum16 = 1 << 5,
+  xor8 = 1 << 6,
+  lrc8 = 1 << 7,
+  fletcher16 = 1 << 8,
+  fletcher32 = 1 << 9,
+  crc64 = 1 << 10,
+  crc64_ecma = 1 << 11,
+  adler32 = 1 << 12,
+  xxh64 = 1 << 13,
+  xxh3_64 = 1 << 14,
+  xxh3_128 = 1 << 15,
+  all = (1 << 16) - 1
+};
+
+constexpr checksum operator|(checksum a, checksum b)
+{
+  return static_cast<checksum>(static_cast<unsigned int>(a) | static_cast<unsigned int>(b));
+}
+
+struct checksums
+{
+  uint8_t crc8 = 0;
+  uint16_t crc16 = 0;
+  uint32_t crc32 = 0;
+  uint32_t crc32c = 0;
+  uint8_t sum8 = 0;
+  uint16_t sum16 = 0;
+  uint8_t xor8 = 0;
+  uint8_t lrc8 = 0;
+  uint16_t fletcher16 = 0;
+  uint32_t fletcher32 = 0;
+  uint64_t crc64 = 0;
+  uint64_t crc64_ecma = 0;
+  uint32_t adler32 = 0;
+  uint64_t xxh64 = 0;
+  uint64_t xxh3_64 = 0;
+  hash128 xxh3_128 = {0, 0};
+};
+
+// 数据按缓存大小的小块依次送入每个选中的校验, 每块只从内存读取一次
+class multi_hasher
+{
+ public:
+  explicit multi_hasher(checksum which);
+
+  void update(const void *data, size_t len);
+  void update(const std::string &data)
+  {
+    update(data.data(), data.size());
+  }
+  checksums value() const noexcept;
+  void reset() noexcept;
+
+ private:
+  bool selected(checksum c) const noexcept
+  {
+    return (which_ & static_cast<unsigned int>(c)) != 0;
+  }
+
+  unsigned int which_;
+  crc8_hasher crc8_;
+  crc16_hasher crc16_;
+  crc32_hasher crc32_;
+  crc32c_hasher crc32c_;
+  sum8_hasher sum8_;
+  sum16_hasher sum16_;
+  xor8_hasher xor8_;
+  lrc8_hasher lrc8_;
+  fletcher16_hasher fletcher16_;
+  fletcher32_hasher fletcher32_;
+  crc64_hasher crc64_;
+  crc64_ecma_hasher crc64_ecma_;
+  adler32_hasher adler32_;
+  xxh64_hasher xxh64_;
+  xxh3_64_hasher xxh3_64_;
+  xxh3_128_hasher xxh3_128_;
+};
+
+checksums multi_checksum(const std::string &data, checksum which);
+
+// 文件只读取一遍; 文件无法打开或读取出错时返回 false
+bool multi_checksum_file(const std::string &filepath, checksum which, checksums &result, size_t buffer_size = 0);
 
 }  // namespace checkutils
 
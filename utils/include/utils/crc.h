@@ -0,0 +1,257 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file crc.h
+ * @brief 按 Rocksoft 模型参数化的通用 CRC (查找表在编译期生成)
+ *
+ * crc<Width, Poly, Init, RefIn, RefOut, XorOut> 覆盖 1 ~ 64 位的任意 CRC, 参数含义与
+ * CRC RevEng 目录 (https://reveng.sourceforge.io/crc-catalogue/) 相同, Poly/Init/XorOut 均为未反射的值:
+ *
+ *   checkutils::crc_catalog::crc16_ccitt_false::compute("123456789", 9);  // 0x29B1
+ *
+ *   checkutils::crc_catalog::crc64_xz hasher;                             // 增量计算
+ *   hasher.update(data, len);
+ *   uint64_t value = hasher.value();
+ *
+ * 每个变体使用 16 张 256 项的 slicing-by-16 查找表, 由 constexpr 函数在编译期生成.
+ * checkutils::crc32() / crc32c() 在此基础上还会使用 PCLMULQDQ / SSE4.2 指令.
+ *
+ * @author abin
+ * @date 2025-12-16
+ */
+
+#ifndef __GUARD_CRC_H_INCLUDE_GUARD__
+#define __GUARD_CRC_H_INCLUDE_GUARD__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "utils/detail/index_seq.h"
+
+namespace checkutils
+{
+namespace crc_detail
+{
+
+using utils_detail::index_seq;
+using utils_detail::make_seq;
+
+// 能容纳 Width 位寄存器的最小无符号整数类型
+template <unsigned int Width>
+struct register_type
+{
+  using type = typename std::conditional<
+    Width <= 8, uint8_t,
+    typename std::conditional<Width <= 16, uint16_t,
+                              typename std::conditional<Width <= 32, uint32_t, uint64_t>::type>::type>::type;
+};
+
+constexpr size_t slices = 16;
+
+// 低 width 位按位反转
+constexpr uint64_t reflect(uint64_t value, unsigned int width)
+{
+  return width == 0 ? 0 : ((value & 1) << (width - 1)) | reflect(value >> 1, width - 1);
+}
+
+// 逐位移入 bits 个零位; 反射时寄存器在低位 (右移), 否则在高位 (左移)
+template <typename T>
+constexpr T shift_bits(T reg, T poly, bool reflected, unsigned int bits)
+{
+  return bits == 0 ? reg
+         : reflected
+           ? shift_bits<T>(static_cast<T>((reg & 1U) != 0 ? (reg >> 1) ^ poly : reg >> 1), poly, reflected, bits - 1)
+           : shift_bits<T>(static_cast<T>((reg >> (8 * sizeof(T) - 1)) != 0 ? (reg << 1) ^ poly : reg << 1), poly,
+                           reflected, bits - 1);
+}
+
+// table[k * 256 + n]: 寄存器中与当前字节对齐的部分为 n, 之后再经过 k 个零字节的结果
+template <typename T, size_t... I>
+constexpr std::array<T, sizeof...(I)> make_table(T poly, bool reflected, index_seq<I...>)
+{
+  return std::array<T, sizeof...(I)>{{shift_bits<T>(
+    static_cast<T>(reflected ? I % 256 : static_cast<T>(I % 256) << (8 * sizeof(T) - 8)), poly, reflected,
+    static_cast<unsigned int>(8 * (I / 256 + 1)))...}};
+}
+
+// Poly 为寄存器中的多项式: 反射时已反转, 否则左对齐到 T 的最高位
+template <typename T, T Poly, bool Reflected>
+struct crc_table
+{
+  static constexpr std::array<T, slices * 256> value =
+    make_table<T>(Poly, Reflected, typename make_seq<slices * 256>::type());
+};
+
+template <typename T, T Poly, bool Reflected>
+constexpr std::array<T, slices * 256> crc_table<T, Poly, Reflected>::value;
+
+// 一次处理 16 字节时的第 i 个字节: 前 sizeof(T) 个字节与寄存器中对应的字节异或
+// (反射时寄存器的最低字节对应 buf[0], 否则最高字节对应 buf[0])
+template <typename T, bool Reflected>
+inline unsigned int slice_byte(T reg, const unsigned char *buf, unsigned int i)
+{
+  return i >= sizeof(T) ? buf[i]
+                        : (buf[i] ^ static_cast<unsigned int>(static_cast<uint64_t>(reg) >>
+                                                              (Reflected ? 8 * i : 8 * (sizeof(T) - 1 - i)))) &
+                            0xFF;
+}
+
+// 更新寄存器: 每次 16 字节, 剩余部分逐字节查表
+template <typename T, T Poly, bool Reflected>
+T update(T reg, const unsigned char *buf, size_t len)
+{
+  // 分成四组异或以缩短依赖链; 在 32/64 位整数上运算, 避免 16 位指令的部分寄存器开销
+  using word = typename std::conditional<sizeof(T) <= 4, uint32_t, uint64_t>::type;
+  const T *table = crc_table<T, Poly, Reflected>::value.data();
+  for (; len >= slices; len -= slices, buf += slices)
+  {
+    const word a = static_cast<word>(table[15 * 256 + slice_byte<T, Reflected>(reg, buf, 0)]) ^
+                   table[14 * 256 + slice_byte<T, Reflected>(reg, buf, 1)] ^
+                   table[13 * 256 + slice_byte<T, Reflected>(reg, buf, 2)] ^
+                   table[12 * 256 + slice_byte<T, Reflected>(reg, buf, 3)];
+    const word b = static_cast<word>(table[11 * 256 + slice_byte<T, Reflected>(reg, buf, 4)]) ^
+                   table[10 * 256 + slice_byte<T, Reflected>(reg, buf, 5)] ^
+                   table[9 * 256 + slice_byte<T, Reflected>(reg, buf, 6)] ^
+                   table[8 * 256 + slice_byte<T, Reflected>(reg, buf, 7)];
+    const word c = static_cast<word>(table[7 * 256 + buf[8]]) ^ table[6 * 256 + buf[9]] ^ table[5 * 256 + buf[10]] ^
+                   table[4 * 256 + buf[11]];
+    const word d = static_cast<word>(table[3 * 256 + buf[12]]) ^ table[2 * 256 + buf[13]] ^ table[1 * 256 + buf[14]] ^
+                   table[buf[15]];
+    reg = static_cast<T>((a ^ b) ^ (c ^ d));
+  }
+
+  const unsigned int top = 8 * sizeof(T) - 8;  // 非反射时寄存器最高字节的位置
+  for (; len != 0; --len, ++buf)
+  {
+    reg = Reflected ? static_cast<T>((static_cast<uint64_t>(reg) >> 8) ^ table[(reg ^ *buf) & 0xFF])
+                    : static_cast<T>((static_cast<uint64_t>(reg) << 8) ^ table[((reg >> top) ^ *buf) & 0xFF]);
+  }
+  return reg;
+}
+
+}  // namespace crc_detail
+
+template <unsigned int Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut>
+class crc
+{
+  static_assert(Width >= 1 && Width <= 64, "CRC width must be between 1 and 64");
+
+ public:
+  using value_type = typename crc_detail::register_type<Width>::type;
+
+  static constexpr unsigned int width = Width;
+
+  crc() noexcept :
+    reg_(initial_register())
+  {
+  }
+
+  void update(const void *data, size_t len)
+  {
+    reg_ = crc_detail::update<value_type, table_poly, RefIn>(reg_, static_cast<const unsigned char *>(data), len);
+  }
+  void update(const std::string &data)
+  {
+    update(data.data(), data.size());
+  }
+
+  value_type value() const noexcept
+  {
+    return from_register(reg_);
+  }
+
+  void reset() noexcept
+  {
+    reg_ = initial_register();
+  }
+
+  static value_type compute(const void *data, size_t len)
+  {
+    return extend(initial_value(), data, len);
+  }
+  static value_type compute(const std::string &data)
+  {
+    return compute(data.data(), data.size());
+  }
+
+  // 在之前数据的结果 previous 之后继续计算 data, 得到拼接后数据的 CRC
+  static value_type extend(value_type previous, const void *data, size_t len)
+  {
+    return from_register(crc_detail::update<value_type, table_poly, RefIn>(
+      to_register(previous), static_cast<const unsigned char *>(data), len));
+  }
+
+  // 空输入的结果
+  static constexpr value_type initial_value()
+  {
+    return from_register(initial_register());
+  }
+
+ private:
+  static constexpr unsigned int shift = 8 * sizeof(value_type) - Width;  // 非反射寄存器的左对齐位数
+  static constexpr uint64_t mask = Width == 64 ? ~uint64_t(0) : (uint64_t(1) << Width) - 1;
+  static constexpr value_type table_poly =
+    static_cast<value_type>(RefIn ? crc_detail::reflect(Poly & mask, Width) : (Poly & mask) << shift);
+
+  static constexpr value_type initial_register()
+  {
+    return static_cast<value_type>(RefIn ? crc_detail::reflect(Init & mask, Width) : (Init & mask) << shift);
+  }
+
+  // RefIn 与 RefOut 不同时输出前 (输入后) 再反转一次
+  static constexpr uint64_t reflect_out(uint64_t v)
+  {
+    return RefIn != RefOut ? crc_detail::reflect(v, Width) : v;
+  }
+
+  static constexpr value_type from_register(value_type reg)
+  {
+    return static_cast<value_type>((reflect_out(RefIn ? reg : reg >> shift) ^ XorOut) & mask);
+  }
+
+  static constexpr value_type to_register(value_type value)
+  {
+    return static_cast<value_type>(RefIn ? reflect_out((value ^ XorOut) & mask)
+                                         : reflect_out((value ^ XorOut) & mask) << shift);
+  }
+
+  value_type reg_;
+};
+
+template <unsigned int Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut>
+constexpr unsigned int crc<Width, Poly, Init, RefIn, RefOut, XorOut>::width;
+
+// ---------------- 常用 CRC (名称与 CRC RevEng 目录一致) ----------------
+namespace crc_catalog
+{
+// 名称                                   Width Poly                 Init                  RefIn  RefOut XorOut
+using crc3_gsm = crc<3, 0x3, 0x0, false, false, 0x7>;
+using crc5_usb = crc<5, 0x05, 0x1F, true, true, 0x1F>;
+using crc8_smbus = crc<8, 0x07, 0x00, false, false, 0x00>;  // checkutils::crc8()
+using crc8_maxim = crc<8, 0x31, 0x00, true, true, 0x00>;    // Dallas 1-Wire
+using crc8_autosar = crc<8, 0x2F, 0xFF, false, false, 0xFF>;
+using crc12_umts = crc<12, 0x80F, 0x000, false, true, 0x000>;
+using crc15_can = crc<15, 0x4599, 0x0000, false, false, 0x0000>;
+using crc16_modbus = crc<16, 0x8005, 0xFFFF, true, true, 0x0000>;  // checkutils::crc16()
+using crc16_arc = crc<16, 0x8005, 0x0000, true, true, 0x0000>;
+using crc16_usb = crc<16, 0x8005, 0xFFFF, true, true, 0xFFFF>;
+using crc16_ccitt_false = crc<16, 0x1021, 0xFFFF, false, false, 0x0000>;  // CRC-16/IBM-3740
+using crc16_xmodem = crc<16, 0x1021, 0x0000, false, false, 0x0000>;
+using crc16_kermit = crc<16, 0x1021, 0x0000, true, true, 0x0000>;
+using crc16_x25 = crc<16, 0x1021, 0xFFFF, true, true, 0xFFFF>;  // CRC-16/IBM-SDLC
+using crc32_iso_hdlc = crc<32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0xFFFFFFFF>;  // checkutils::crc32()
+using crc32_iscsi = crc<32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF>;     // checkutils::crc32c()
+using crc32_bzip2 = crc<32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF>;
+using crc32_mpeg2 = crc<32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0x00000000>;
+using crc32_cksum = crc<32, 0x04C11DB7, 0x00000000, false, false, 0xFFFFFFFF>;  // POSIX cksum
+using crc64_xz = crc<64, 0x42F0E1EBA9EA3693, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF>;
+using crc64_ecma_182 = crc<64, 0x42F0E1EBA9EA3693, 0x0000000000000000, false, false, 0x0000000000000000>;
+}  // namespace crc_catalog
+
+}  // namespace checkutils
+
+#endif  // __GUARD_CRC_H_INCLUDE_GUARD__
@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file index_seq.h
+ * @brief 编译期整数序列（base64_constexpr.h / crc.h 内部使用）
+ *
+ * C++11 没有 std::index_sequence; make_seq<N>::type 为 index_seq<0, 1, ..., N - 1>,
+ * 对半拼接, 模板递归深度为 log(N).
+ *
+ * @author abin
+ * @date 2025-12-10
+ */
+
+#ifndef __GUARD_INDEX_SEQ_H_INCLUDE_GUARD__
+#define __GUARD_INDEX_SEQ_H_INCLUDE_GUARD__
+
+#include <cstddef>
+
+namespace utils_detail
+{
+
+template <size_t... I>
+struct index_seq
+{
+};
+
+template <typename A, typename B>
+struct concat_seq;
+
+template <size_t... A, size_t... B>
+struct concat_seq<index_seq<A...>, index_seq<B...>>
+{
+  using type = index_seq<A..., (sizeof...(A) + B)...>;
+};
+
+template <size_t N>
+struct make_seq
+{
+  using type = typename concat_seq<typename make_seq<N / 2>::type, typename make_seq<N - N / 2>::type>::type;
+};
+
+template <>
+struct make_seq<0>
+{
+  using type = index_seq<>;
+};
+
+template <>
+struct make_seq<1>
+{
+  using type = index_seq<0>;
+};
+
+}  // namespace utils_detail
+
+#endif  // __GUARD_INDEX_SEQ_H_INCLUDE_GUARD__
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file hex.h
+ * @brief 十六进制 (base16) 编解码
+ *
+ * 整块数据的编解码在运行时按 CPU 特性分派到 SSSE3/AVX2 内核;
+ * hex_digit()/hex_value() 用于百分号编码、UUID 等逐字节的场景.
+ *
+ * @author abin
+ * @date 2025-12-11
+ */
+
+#ifndef __GUARD_HEX_H_INCLUDE_GUARD__
+#define __GUARD_HEX_H_INCLUDE_GUARD__
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace codec
+{
+
+// 解码遇到非十六进制字符或奇数长度时抛出, position() 为出错字符的偏移
+class hex_error : public std::runtime_error
+{
+ public:
+  explicit hex_error(size_t position);
+
+  size_t position() const noexcept
+  {
+    return position_;
+  }
+
+ private:
+  size_t position_;
+};
+
+// ---------------- 单个字符 ----------------
+// 4 bit 值 -> 十六进制字符
+inline char hex_digit(unsigned int value, bool uppercase = false) noexcept
+{
+  return (uppercase ? "0123456789ABCDEF" : "0123456789abcdef")[value & 0x0F];
+}
+
+// 十六进制字符 (大小写均可) -> 4 bit 值, 非法字符返回 -1
+inline int hex_value(char c) noexcept
+{
+  return c >= '0' && c <= '9'   ? c - '0'
+         : c >= 'a' && c <= 'f' ? c - 'a' + 10
+         : c >= 'A' && c <= 'F' ? c - 'A' + 10
+                                : -1;
+}
+
+// ---------------- 编码 ----------------
+std::string hex_encode(const unsigned char *data, size_t len, bool uppercase = false);
+std::string hex_encode(const std::string &data, bool uppercase = false);
+
+// 写入调用方的缓冲区 (需要 2 * len 字节, 不足时抛出 std::length_error), 返回写入的字符数
+size_t hex_encode_to(const unsigned char *data, size_t len, char *out, size_t out_capacity, bool uppercase = false);
+
+// ---------------- 解码 (大小写均可) ----------------
+std::string hex_decode(const char *hex, size_t len);
+std::string hex_decode(const std::string &hex);
+
+// 写入调用方的缓冲区 (需要 len / 2 字节, 不足时抛出 std::length_error), 返回写入的字节数
+size_t hex_decode_to(const char *hex, size_t len, unsigned char *out, size_t out_capacity);
+
+}  // namespace codec
+
+#endif  // __GUARD_HEX_H_INCLUDE_GUARD__
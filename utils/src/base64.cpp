@@ -9,6 +9,15 @@
 
    Copyright (C) 2004-2017, 2020-2022 René Nyffenegger
 
+   Altered for mutils: encoder and decoder write into presized buffers
+   and dispatch to SSSE3/AVX2/AVX-512 VBMI kernels (base64_simd.cpp)
+   at runtime. The decoder translates through a lookup table and
+   reports the offset of the first invalid character (base64_error).
+   PEM/MIME line breaks are written while encoding (insert_linebreaks
+   is gone) and skipped while decoding, without copying the input.
+   Added streaming encoder/decoder classes, a multi-threaded mode for
+   large buffers and file-to-file encoding and decoding.
+
    This source code is provided 'as-is', without any express or implied
    warranty. In no event will the author be held liable for any damages
    arising from the use of this software.
@@ -34,7 +43,13 @@
 #include "utils/base64.h"
 
 #include <algorithm>
+#include <cstring>
 #include <stdexcept>
+#include <vector>
+
+#include "base64_simd.h"
+#include "file_io.h"
+#include "parallel.h"
 
 namespace codec
 {
@@ -54,260 +69,1350 @@ static const char* base64_chars[2] = {
     "0123456789"
     "-_"};
 
-static unsigned int pos_of_char(const unsigned char chr)
+//
+// Maps every input byte to its 6-bit value, or to 0xff for bytes that
+// are not base64 characters. Be liberal with input and accept both url
+// ('-', '_') and non-url ('+', '/') base 64 characters.
+//
+static const unsigned char base64_values[256] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,   62, 0xff,   62, 0xff,   63,
+      52,   53,   54,   55,   56,   57,   58,   59,   60,   61, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff,    0,    1,    2,    3,    4,    5,    6,    7,    8,    9,   10,   11,   12,   13,   14,
+      15,   16,   17,   18,   19,   20,   21,   22,   23,   24,   25, 0xff, 0xff, 0xff, 0xff,   63,
+    0xff,   26,   27,   28,   29,   30,   31,   32,   33,   34,   35,   36,   37,   38,   39,   40,
+      41,   42,   43,   44,   45,   46,   47,   48,   49,   50,   51, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+static bool is_padding(unsigned char chr)
 {
     //
-    // Return the position of chr within base64_encode()
+    // accept URL-safe base 64 strings, too, so check for '.' also.
     //
+    return chr == '=' || chr == '.';
+}
 
-    if (chr >= 'A' && chr <= 'Z')
-        return chr - 'A';
-    else if (chr >= 'a' && chr <= 'z')
-        return chr - 'a' + ('Z' - 'A') + 1;
-    else if (chr >= '0' && chr <= '9')
-        return chr - '0' + ('Z' - 'A') + ('z' - 'a') + 2;
-    else if (chr == '+' || chr == '-')
-        return 62;  // Be liberal with input and accept both url ('-') and non-url ('+') base 64 characters (
-    else if (chr == '/' || chr == '_')
-        return 63;  // Ditto for '/' and '_'
-    else
-        //
-        // 2020-10-23: Throw std::exception rather than const char*
-        //(Pablo Martin-Gomez, https://github.com/Bouska)
-        //
-        throw std::runtime_error("Input is not valid base64-encoded data.");
+base64_error::base64_error(size_t position)
+    : std::runtime_error("Input is not valid base64-encoded data (at offset " + std::to_string(position) + ")."),
+      position_(position)
+{
+}
+
+template <typename String>
+static std::string encode_pem(String const& s, bool crlf)
+{
+    return base64_encode_wrapped(reinterpret_cast<const unsigned char*>(s.data()), s.length(), 64, crlf);
+}
+
+template <typename String>
+static std::string encode_mime(String const& s, bool crlf)
+{
+    return base64_encode_wrapped(reinterpret_cast<const unsigned char*>(s.data()), s.length(), 76, crlf);
+}
+
+template <typename String>
+static std::string encode(String const& s, bool url)
+{
+    return base64_encode(reinterpret_cast<const unsigned char*>(s.data()), s.length(), url);
 }
 
-static std::string insert_linebreaks(std::string str, size_t distance)
+static size_t encode_scalar(unsigned char const* bytes_to_encode, size_t in_len, char* out, bool url)
 {
     //
-    // Provided by https://github.com/JomaCorpFX, adapted by me.
+    // Encode all complete 3-byte groups first, so that the main loop does
+    // not need to check for the end of the input, and handle the 1 or 2
+    // remaining bytes afterwards.
     //
-    if (!str.length())
+    const char* base64_chars_ = base64_chars[url];
+    const char trailing_char = url ? '.' : '=';
+
+    char* const begin = out;
+    size_t pos = 0;
+
+    for (; pos + 3 <= in_len; pos += 3)
     {
-        return "";
+        const unsigned int triple = (static_cast<unsigned int>(bytes_to_encode[pos + 0]) << 16) |
+                                    (static_cast<unsigned int>(bytes_to_encode[pos + 1]) << 8) |
+                                    bytes_to_encode[pos + 2];
+        out[0] = base64_chars_[(triple >> 18) & 0x3f];
+        out[1] = base64_chars_[(triple >> 12) & 0x3f];
+        out[2] = base64_chars_[(triple >> 6) & 0x3f];
+        out[3] = base64_chars_[triple & 0x3f];
+        out += 4;
     }
 
-    size_t pos = distance;
-
-    while (pos < str.size())
+    if (pos + 1 == in_len)
+    {
+        out[0] = base64_chars_[(bytes_to_encode[pos + 0] & 0xfc) >> 2];
+        out[1] = base64_chars_[(bytes_to_encode[pos + 0] & 0x03) << 4];
+        out[2] = trailing_char;
+        out[3] = trailing_char;
+        out += 4;
+    }
+    else if (pos + 2 == in_len)
     {
-        str.insert(pos, "\n");
-        pos += distance + 1;
+        out[0] = base64_chars_[(bytes_to_encode[pos + 0] & 0xfc) >> 2];
+        out[1] = base64_chars_[((bytes_to_encode[pos + 0] & 0x03) << 4) + ((bytes_to_encode[pos + 1] & 0xf0) >> 4)];
+        out[2] = base64_chars_[(bytes_to_encode[pos + 1] & 0x0f) << 2];
+        out[3] = trailing_char;
+        out += 4;
     }
 
-    return str;
+    return static_cast<size_t>(out - begin);
 }
 
-template <typename String, unsigned int line_length>
-static std::string encode_with_line_breaks(String s)
+static detail::base64_encode_kernel select_encode_kernel()
 {
-    return insert_linebreaks(base64_encode(s, false), line_length);
+    //
+    // Pick the widest vectorized kernel the CPU (and OS) supports.
+    // The kernels only handle the bulk of the input, the scalar
+    // code above always encodes the remaining tail.
+    //
+#if UTILS_X86_SIMD
+    const cpu::feature_set& f = cpu::features();
+    if (f.avx512vbmi) return detail::base64_encode_avx512vbmi;
+    if (f.avx2) return detail::base64_encode_avx2;
+    if (f.ssse3) return detail::base64_encode_ssse3;
+#endif  // UTILS_X86_SIMD
+    return nullptr;
 }
 
-template <typename String>
-static std::string encode_pem(String s)
+static size_t encode_into(unsigned char const* bytes_to_encode, size_t in_len, char* out, bool url)
 {
-    return encode_with_line_breaks<String, 64>(s);
-}
+    //
+    // Writes exactly (in_len + 2) / 3 * 4 characters to out.
+    //
+    static const detail::base64_encode_kernel kernel = select_encode_kernel();
 
-template <typename String>
-static std::string encode_mime(String s)
-{
-    return encode_with_line_breaks<String, 76>(s);
+    size_t consumed = 0;
+    if (kernel != nullptr)
+    {
+        consumed = kernel(bytes_to_encode, in_len, out, url);
+    }
+
+    size_t written = consumed / 3 * 4;
+    return written + encode_scalar(bytes_to_encode + consumed, in_len - consumed, out + written, url);
 }
 
-template <typename String>
-static std::string encode(String s, bool url)
+static size_t wrapped_length(size_t chars, size_t column, size_t line_length, bool crlf)
 {
-    return base64_encode(reinterpret_cast<const unsigned char*>(s.data()), s.length(), url);
+    //
+    // Length of chars encoded characters with line breaks, if the current
+    // line already has column characters. A line break is written before
+    // every character that starts a new line.
+    //
+    if (line_length == 0 || chars == 0) return chars;
+    return chars + (column + chars - 1) / line_length * (crlf ? 2 : 1);
 }
 
-std::string base64_encode(unsigned char const* bytes_to_encode, size_t in_len, bool url)
+static size_t encode_wrapped_into(unsigned char const* bytes_to_encode, size_t in_len, char* out, size_t line_length,
+                                  bool crlf, bool url, size_t& column)
 {
-    size_t len_encoded = (in_len + 2) / 3 * 4;
-
-    unsigned char trailing_char = url ? '.' : '=';
-
     //
-    // Choose set of base64 characters. They differ
-    // for the last two positions, depending on the url
-    // parameter.
-    // A bool (as is the parameter url) is guaranteed
-    // to evaluate to either 0 or 1 in C++ therefore,
-    // the correct character set is chosen by subscripting
-    // base64_chars with url.
+    // Writes wrapped_length(base64_encoded_size(in_len), column, line_length,
+    // crlf) characters. column is the number of characters in the current
+    // line, 0 at the start of the encoding, and is updated for continuing
+    // the encoding (see base64_encoder).
     //
-    const char* base64_chars_ = base64_chars[url];
+    // The input is encoded block by block into a small buffer that stays
+    // in L1 cache, and copied from there to the output line by line. This
+    // replaces the former insert_linebreaks(), which shifted the whole
+    // tail of the string for every line (O(n^2)).
+    //
+    if (line_length == 0)
+    {
+        return encode_into(bytes_to_encode, in_len, out, url);
+    }
 
-    std::string ret;
-    ret.reserve(len_encoded);
+    char block[4096];
+    const size_t block_bytes = sizeof(block) / 4 * 3;
 
-    unsigned int pos = 0;
+    char* const begin = out;
+    size_t pos = 0;
 
     while (pos < in_len)
     {
-        ret.push_back(base64_chars_[(bytes_to_encode[pos + 0] & 0xfc) >> 2]);
+        const size_t n = std::min(block_bytes, in_len - pos);
+        size_t chars = encode_into(bytes_to_encode + pos, n, block, url);
+        const char* src = block;
+        pos += n;
 
-        if (pos + 1 < in_len)
+        while (chars > 0)
         {
-            ret.push_back(
-                base64_chars_[((bytes_to_encode[pos + 0] & 0x03) << 4) + ((bytes_to_encode[pos + 1] & 0xf0) >> 4)]);
-
-            if (pos + 2 < in_len)
-            {
-                ret.push_back(
-                    base64_chars_[((bytes_to_encode[pos + 1] & 0x0f) << 2) + ((bytes_to_encode[pos + 2] & 0xc0) >> 6)]);
-                ret.push_back(base64_chars_[bytes_to_encode[pos + 2] & 0x3f]);
-            }
-            else
+            //
+            // The line break is only written once the next line starts,
+            // so there is none after the last line.
+            //
+            if (column == line_length)
             {
-                ret.push_back(base64_chars_[(bytes_to_encode[pos + 1] & 0x0f) << 2]);
-                ret.push_back(trailing_char);
+                if (crlf) *out++ = '\r';
+                *out++ = '\n';
+                column = 0;
             }
+
+            const size_t take = std::min(chars, line_length - column);
+            std::memcpy(out, src, take);
+            out += take;
+            src += take;
+            chars -= take;
+            column += take;
         }
-        else
-        {
-            ret.push_back(base64_chars_[(bytes_to_encode[pos + 0] & 0x03) << 4]);
-            ret.push_back(trailing_char);
-            ret.push_back(trailing_char);
-        }
+    }
 
-        pos += 3;
+    return static_cast<size_t>(out - begin);
+}
+
+std::string base64_encode(unsigned char const* bytes_to_encode, size_t in_len, bool url)
+{
+    size_t len_encoded = (in_len + 2) / 3 * 4;
+
+    std::string ret(len_encoded, '\0');
+    if (len_encoded != 0)
+    {
+        encode_into(bytes_to_encode, in_len, &ret[0], url);
     }
 
     return ret;
 }
 
-template <typename String>
-static std::string decode(String const& encoded_string, bool remove_linebreaks)
+static const size_t no_error = static_cast<size_t>(-1);
+
+static size_t decoded_upper_bound(size_t in_len)
 {
     //
-    // decode(…) is templated so that it can be used with String = const std::string&
-    // or std::string_view (requires at least C++17)
+    // Every complete chunk of 4 characters produces 3 bytes, a last
+    // chunk of 2 or 3 characters (without padding) 1 or 2 bytes.
     //
+    return in_len / 4 * 3 + in_len % 4 * 3 / 4;
+}
 
-    if (encoded_string.empty()) return std::string();
+static detail::base64_decode_kernel select_decode_kernel()
+{
+#if UTILS_X86_SIMD
+    const cpu::feature_set& f = cpu::features();
+    if (f.avx512vbmi) return detail::base64_decode_avx512vbmi;
+    if (f.avx2) return detail::base64_decode_avx2;
+    if (f.ssse3) return detail::base64_decode_ssse3;
+#endif  // UTILS_X86_SIMD
+    return nullptr;
+}
 
-    if (remove_linebreaks)
+static bool is_skipped(unsigned char chr, unsigned int skip)
+{
+    switch (chr)
     {
-        std::string copy(encoded_string);
-
-        copy.erase(std::remove(copy.begin(), copy.end(), '\n'), copy.end());
+    case '\n':
+        return (skip & static_cast<unsigned int>(base64_skip::lf)) != 0;
+    case '\r':
+        return (skip & static_cast<unsigned int>(base64_skip::cr)) != 0;
+    case ' ':
+        return (skip & static_cast<unsigned int>(base64_skip::space)) != 0;
+    case '\t':
+        return (skip & static_cast<unsigned int>(base64_skip::tab)) != 0;
+    default:
+        return false;
+    }
+}
 
-        return base64_decode(copy, false);
+static size_t gather_chunk(unsigned char const* in, size_t in_len, size_t& pos, unsigned int skip,
+                           unsigned char chunk[4], size_t offset[4])
+{
+    //
+    // Collects the (up to) four characters of the chunk at pos without the
+    // skipped ones, together with their offsets for error reporting, and
+    // returns their number.
+    //
+    size_t chunk_len = 0;
+    while (chunk_len < 4 && pos < in_len)
+    {
+        if (skip == 0 || !is_skipped(in[pos], skip))
+        {
+            chunk[chunk_len] = in[pos];
+            offset[chunk_len] = pos;
+            ++chunk_len;
+        }
+        ++pos;
     }
 
-    size_t length_of_string = encoded_string.length();
-    size_t pos = 0;
+    return chunk_len;
+}
 
+static size_t decode_chunk(unsigned char const chunk[4], size_t chunk_len, size_t const offset[4], unsigned char* out,
+                           size_t& error_pos)
+{
     //
-    // The approximate length (bytes) of the decoded string might be one or
-    // two bytes smaller, depending on the amount of trailing equal signs
-    // in the encoded string. This approximation is needed to reserve
-    // enough space in the string to be returned.
+    // Decodes a (possibly short or padded) chunk of 1 to 4 characters and
+    // returns the number of bytes written, at least one and up to three,
+    // or 0 with error_pos set to the offset of the offending character.
     //
-    size_t approx_length_of_decoded_string = length_of_string / 4 * 3;
-    std::string ret;
-    ret.reserve(approx_length_of_decoded_string);
+    if (chunk_len < 2)
+    {
+        error_pos = offset[0];
+        return 0;
+    }
 
-    while (pos < length_of_string)
+    unsigned char* const begin = out;
+    const unsigned int v0 = base64_values[chunk[0]];
+    const unsigned int v1 = base64_values[chunk[1]];
+    if (v0 > 63 || v1 > 63)
+    {
+        error_pos = v0 > 63 ? offset[0] : offset[1];
+        return 0;
+    }
+    *out++ = static_cast<unsigned char>((v0 << 2) | (v1 >> 4));
+
+    if (chunk_len > 2 && !is_padding(chunk[2]))
+    {
+        const unsigned int v2 = base64_values[chunk[2]];
+        if (v2 > 63)
+        {
+            error_pos = offset[2];
+            return 0;
+        }
+        *out++ = static_cast<unsigned char>(((v1 & 0x0f) << 4) | (v2 >> 2));
+
+        if (chunk_len > 3 && !is_padding(chunk[3]))
+        {
+            const unsigned int v3 = base64_values[chunk[3]];
+            if (v3 > 63)
+            {
+                error_pos = offset[3];
+                return 0;
+            }
+            *out++ = static_cast<unsigned char>(((v2 & 0x03) << 6) | v3);
+        }
+    }
+    else if (chunk_len > 3 && !is_padding(chunk[3]))
     {
         //
-        // Iterate over encoded input string in chunks. The size of all
-        // chunks except the last one is 4 bytes.
-        //
-        // The last chunk might be padded with equal signs or dots
-        // in order to make it 4 bytes in size as well, but this
-        // is not required as per RFC 2045.
+        // Data after the padding of the same chunk
         //
-        // All chunks except the last one produce three output bytes.
+        error_pos = offset[3];
+        return 0;
+    }
+
+    return static_cast<size_t>(out - begin);
+}
+
+static size_t decode_chunks(char const* encoded, size_t in_len, unsigned char* out, unsigned int skip,
+                            size_t& error_pos, size_t* held_back = nullptr)
+{
+    //
+    // Decodes in_len characters into out, which must have room for
+    // decoded_upper_bound(in_len) bytes, and returns the number of bytes
+    // written. Characters selected by skip (a base64_skip mask) are
+    // ignored wherever they occur. On invalid input error_pos is set to
+    // the offset of the first offending character, otherwise to no_error.
+    //
+    // Iterate over the encoded input in chunks. The size of all chunks
+    // except the last one is 4 bytes.
+    //
+    // The last chunk might be padded with equal signs or dots in order to
+    // make it 4 bytes in size as well, but this is not required as per
+    // RFC 2045. Padded chunks in the middle of the input (concatenated
+    // encodings) are accepted, too.
+    //
+    // If held_back is given, the input is not the end of the encoded data
+    // (see base64_decoder): an incomplete last chunk is only validated, not
+    // decoded, and *held_back is set to the number of its characters.
+    //
+    static const detail::base64_decode_kernel kernel = select_decode_kernel();
+
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(encoded);
+    unsigned char* const begin = out;
+    size_t pos = 0;
+    error_pos = no_error;
+    if (held_back != nullptr) *held_back = 0;
+
+    while (pos < in_len)
+    {
         //
-        // The last chunk produces at least one and up to three bytes.
+        // The vectorized kernel translates and validates whole blocks and
+        // stops at the first block that contains anything else than base64
+        // characters, which the scalar code below then deals with.
         //
+        if (kernel != nullptr)
+        {
+            size_t consumed = kernel(encoded + pos, in_len - pos, out);
+            pos += consumed;
+            out += consumed / 4 * 3;
+        }
+
+        while (pos + 4 <= in_len)
+        {
+            const unsigned int v0 = base64_values[in[pos + 0]];
+            const unsigned int v1 = base64_values[in[pos + 1]];
+            const unsigned int v2 = base64_values[in[pos + 2]];
+            const unsigned int v3 = base64_values[in[pos + 3]];
+            if (((v0 | v1 | v2 | v3) & 0x80) != 0) break;
+
+            const unsigned int triple = (v0 << 18) | (v1 << 12) | (v2 << 6) | v3;
+            out[0] = static_cast<unsigned char>(triple >> 16);
+            out[1] = static_cast<unsigned char>(triple >> 8);
+            out[2] = static_cast<unsigned char>(triple);
+            out += 3;
+            pos += 4;
+        }
 
-        size_t pos_of_char_1 = pos_of_char(encoded_string.at(pos + 1));
+        if (pos >= in_len) break;
 
         //
-        // Emit the first output byte that is produced in each chunk:
+        // A chunk with padding, skipped characters, a short last chunk or
+        // an invalid character. Lines whose length is a multiple of 4 (PEM,
+        // MIME) therefore only take this path once per line break, the rest
+        // of the line goes through the fast paths above, without copying
+        // the input.
         //
-        ret.push_back(static_cast<std::string::value_type>(((pos_of_char(encoded_string.at(pos + 0))) << 2) +
-                                                           ((pos_of_char_1 & 0x30) >> 4)));
-
-        if ((pos + 2 <
-             length_of_string) &&  // Check for data that is not padded with equal signs (which is allowed by RFC 2045)
-            encoded_string.at(pos + 2) != '=' &&
-            encoded_string.at(pos + 2) != '.'  // accept URL-safe base 64 strings, too, so check for '.' also.
-        )
+        unsigned char chunk[4];
+        size_t offset[4];
+        const size_t chunk_len = gather_chunk(in, in_len, pos, skip, chunk, offset);
+
+        if (chunk_len == 0) break;  // nothing but skipped characters left
+        if (chunk_len < 4 && held_back != nullptr)
         {
             //
-            // Emit a chunk's second byte (which might not be produced in the last chunk).
+            // Continued by the next piece of input. Padding is only valid
+            // in the third and fourth position of a chunk.
             //
-            unsigned int pos_of_char_2 = pos_of_char(encoded_string.at(pos + 2));
-            ret.push_back(
-                static_cast<std::string::value_type>(((pos_of_char_1 & 0x0f) << 4) + ((pos_of_char_2 & 0x3c) >> 2)));
-
-            if ((pos + 3 < length_of_string) && encoded_string.at(pos + 3) != '=' && encoded_string.at(pos + 3) != '.')
+            for (size_t i = 0; i < chunk_len; ++i)
             {
-                //
-                // Emit a chunk's third byte (which might not be produced in the last chunk).
-                //
-                ret.push_back(static_cast<std::string::value_type>(((pos_of_char_2 & 0x03) << 6) +
-                                                                   pos_of_char(encoded_string.at(pos + 3))));
+                if (base64_values[chunk[i]] > 63 && (i < 2 || !is_padding(chunk[i])))
+                {
+                    error_pos = offset[i];
+                    return 0;
+                }
             }
+            *held_back = chunk_len;
+            break;
+        }
+
+        const size_t written = decode_chunk(chunk, chunk_len, offset, out, error_pos);
+        if (written == 0) return 0;
+        out += written;
+    }
+
+    return static_cast<size_t>(out - begin);
+}
+
+static size_t decode_compacted(char const* encoded, size_t in_len, unsigned char* out, unsigned int skip,
+                               size_t& error_pos, size_t* held_back)
+{
+    //
+    // Fast path for decoding with skipped characters: the input is copied
+    // without the skipped characters into a small buffer that stays in L1
+    // cache (16 bytes at a time where SSSE3 is available), which is then
+    // decoded by the strict decoder at full speed. Only if that fails, the
+    // input is decoded again chunk by chunk to find the offset of the
+    // offending character in the original input.
+    //
+    static const char candidates[4] = {'\n', '\r', ' ', '\t'};
+    char set[4];
+    size_t set_len = 0;
+    for (char c : candidates)
+    {
+        if (is_skipped(static_cast<unsigned char>(c), skip)) set[set_len++] = c;
+    }
+    for (size_t i = set_len; i < 4; ++i) set[i] = set[0];
+
+#if UTILS_X86_SIMD
+    static const bool ssse3 = cpu::features().ssse3;
+#endif  // UTILS_X86_SIMD
+
+    char block[4096];
+    size_t filled = 0;
+    unsigned char* const begin = out;
+    size_t pos = 0;
+
+    for (;;)
+    {
+#if UTILS_X86_SIMD
+        if (ssse3)
+        {
+            size_t consumed;
+            filled += detail::base64_compact_ssse3(encoded + pos, in_len - pos, block + filled, sizeof(block) - filled,
+                                                   set, consumed);
+            pos += consumed;
+        }
+#endif  // UTILS_X86_SIMD
+
+        while (filled < sizeof(block) && pos < in_len)
+        {
+            const char c = encoded[pos++];
+            block[filled] = c;
+            filled += c == set[0] || c == set[1] || c == set[2] || c == set[3] ? 0 : 1;
+        }
+
+        //
+        // Chunks must not be split between two blocks, only the very last
+        // chunk may be shorter than 4 characters.
+        //
+        const bool last = pos >= in_len;
+        const size_t n = last ? filled : filled / 4 * 4;
+
+        out += decode_chunks(block, n, out, 0, error_pos, held_back);
+        if (error_pos != no_error)
+        {
+            return decode_chunks(encoded, in_len, begin, skip, error_pos, held_back);
+        }
+
+        if (last) break;
+
+        std::memmove(block, block + n, filled - n);
+        filled -= n;
+    }
+
+    return static_cast<size_t>(out - begin);
+}
+
+static size_t decode_into(char const* encoded, size_t in_len, unsigned char* out, unsigned int skip,
+                          size_t& error_pos, size_t* held_back = nullptr)
+{
+    //
+    // Decodes in_len characters into out, which must have room for
+    // decoded_upper_bound(in_len) bytes, see decode_chunks().
+    //
+    if (skip == 0)
+    {
+        return decode_chunks(encoded, in_len, out, 0, error_pos, held_back);
+    }
+
+    return decode_compacted(encoded, in_len, out, skip, error_pos, held_back);
+}
+
+static detail::base64_validate_kernel select_validate_kernel()
+{
+#if UTILS_X86_SIMD
+    const cpu::feature_set& f = cpu::features();
+    if (f.avx512bw) return detail::base64_validate_avx512bw;
+    if (f.avx2) return detail::base64_validate_avx2;
+    if (f.ssse3) return detail::base64_validate_ssse3;
+#endif  // UTILS_X86_SIMD
+    return nullptr;
+}
+
+static bool validate_chunks(char const* encoded, size_t in_len, unsigned int skip, size_t& error_pos)
+{
+    //
+    // Accepts exactly the input decode_chunks() accepts, without writing
+    // any output. Runs of base64 characters are only classified (no
+    // translation or packing), the chunks in between are decoded into a
+    // scratch buffer.
+    //
+    static const detail::base64_validate_kernel kernel = select_validate_kernel();
+
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(encoded);
+    size_t pos = 0;
+    error_pos = no_error;
+
+    while (pos < in_len)
+    {
+        if (kernel != nullptr)
+        {
+            pos += kernel(encoded + pos, in_len - pos);
+        }
+
+        while (pos + 4 <= in_len && ((base64_values[in[pos + 0]] | base64_values[in[pos + 1]] |
+                                      base64_values[in[pos + 2]] | base64_values[in[pos + 3]]) &
+                                     0x80) == 0)
+        {
+            pos += 4;
         }
 
-        pos += 4;
+        if (pos >= in_len) break;
+
+        unsigned char chunk[4];
+        size_t offset[4];
+        const size_t chunk_len = gather_chunk(in, in_len, pos, skip, chunk, offset);
+        if (chunk_len == 0) break;
+
+        unsigned char bytes[3];
+        if (decode_chunk(chunk, chunk_len, offset, bytes, error_pos) == 0) return false;
+    }
+
+    return true;
+}
+
+template <typename String>
+static std::string decode(String const& encoded_string, unsigned int skip)
+{
+    //
+    // decode(…) is templated so that it can be used with String = const std::string&
+    // or std::string_view (requires at least C++17)
+    //
+
+    if (encoded_string.empty()) return std::string();
+
+    size_t length_of_string = encoded_string.length();
+
+    std::string ret(decoded_upper_bound(length_of_string), '\0');
+
+    size_t error_pos;
+    size_t written = decode_into(encoded_string.data(), length_of_string, reinterpret_cast<unsigned char*>(&ret[0]),
+                                 skip, error_pos);
+    if (error_pos != no_error)
+    {
+        throw base64_error(error_pos);
     }
 
+    ret.resize(written);
     return ret;
 }
 
-std::string base64_decode(std::string const& s, bool remove_linebreaks)
+template <typename String>
+static std::string decode(String const& encoded_string, bool remove_linebreaks)
 {
-    return decode(s, remove_linebreaks);
+    //
+    // Line breaks are skipped while decoding, the input is not copied.
+    //
+    return decode(encoded_string, static_cast<unsigned int>(remove_linebreaks ? base64_skip::linebreaks
+                                                                               : base64_skip::none));
 }
 
-std::string base64_encode(std::string const& s, bool url)
+size_t base64_encoded_size(size_t len)
 {
-    return encode(s, url);
+    return (len + 2) / 3 * 4;
+}
+
+size_t base64_decoded_size(size_t encoded_len)
+{
+    return decoded_upper_bound(encoded_len);
+}
+
+size_t base64_decoded_length(char const* encoded, size_t len, base64_skip skip) noexcept
+{
+    //
+    // Without skipped characters and without padding before the last
+    // two characters (concatenated encodings), the length follows from the
+    // number of characters. Otherwise every chunk adds 3 bytes per 4 of
+    // its characters that are neither padding nor skipped.
+    //
+    if (skip == base64_skip::none && (len < 2 || (std::memchr(encoded, '=', len - 2) == nullptr &&
+                                                  std::memchr(encoded, '.', len - 2) == nullptr)))
+    {
+        size_t n = len;
+        while (n > 0 && len - n < 2 && (n - 1) % 4 >= 2 && is_padding(static_cast<unsigned char>(encoded[n - 1])))
+        {
+            --n;
+        }
+        return decoded_upper_bound(n);
+    }
+
+    const unsigned int mask = static_cast<unsigned int>(skip);
+    size_t length = 0;
+    size_t chunk_len = 0;
+    size_t data_len = 0;
+    for (size_t pos = 0; pos < len; ++pos)
+    {
+        const unsigned char c = static_cast<unsigned char>(encoded[pos]);
+        if (is_skipped(c, mask)) continue;
+
+        if (!is_padding(c)) ++data_len;
+        if (++chunk_len == 4)
+        {
+            length += data_len * 3 / 4;
+            chunk_len = 0;
+            data_len = 0;
+        }
+    }
+
+    return length + data_len * 3 / 4;
 }
 
-std::string base64_encode_pem(std::string const& s)
+size_t base64_decoded_length(std::string const& s, base64_skip skip) noexcept
 {
-    return encode_pem(s);
+    return base64_decoded_length(s.data(), s.length(), skip);
 }
 
-std::string base64_encode_mime(std::string const& s)
+bool base64_validate(char const* encoded, size_t len, base64_skip skip, size_t* error_pos) noexcept
 {
-    return encode_mime(s);
+    size_t pos;
+    const bool valid = validate_chunks(encoded, len, static_cast<unsigned int>(skip), pos);
+    if (error_pos != nullptr) *error_pos = pos;
+    return valid;
 }
 
-#if __cplusplus >= 201703L
-//
-// Interface with std::string_view rather than const std::string&
-// Requires C++17
-// Provided by Yannic Bonenberger (https://github.com/Yannic)
-//
+bool base64_validate(std::string const& s, base64_skip skip, size_t* error_pos) noexcept
+{
+    return base64_validate(s.data(), s.length(), skip, error_pos);
+}
 
-std::string base64_encode(std::string_view s, bool url)
+size_t base64_encoded_size(size_t len, size_t line_length, bool crlf)
 {
-    return encode(s, url);
+    return wrapped_length(base64_encoded_size(len), 0, line_length, crlf);
 }
 
-std::string base64_encode_pem(std::string_view s)
+std::string base64_encode_wrapped(unsigned char const* bytes_to_encode, size_t in_len, size_t line_length, bool crlf)
 {
-    return encode_pem(s);
+    std::string ret(base64_encoded_size(in_len, line_length, crlf), '\0');
+    if (!ret.empty())
+    {
+        size_t column = 0;
+        encode_wrapped_into(bytes_to_encode, in_len, &ret[0], line_length, crlf, false, column);
+    }
+
+    return ret;
 }
 
-std::string base64_encode_mime(std::string_view s)
+std::string base64_encode_wrapped(std::string const& s, size_t line_length, bool crlf)
 {
-    return encode_mime(s);
+    return base64_encode_wrapped(reinterpret_cast<const unsigned char*>(s.data()), s.length(), line_length, crlf);
 }
 
-std::string base64_decode(std::string_view s, bool remove_linebreaks)
+size_t base64_encode_wrapped_to(unsigned char const* bytes_to_encode, size_t in_len, char* out, size_t out_capacity,
+                                size_t line_length, bool crlf)
 {
-    return decode(s, remove_linebreaks);
+    if (out_capacity < base64_encoded_size(in_len, line_length, crlf))
+    {
+        throw std::length_error("base64_encode_wrapped_to: output buffer too small");
+    }
+
+    size_t column = 0;
+    return encode_wrapped_into(bytes_to_encode, in_len, out, line_length, crlf, false, column);
+}
+
+size_t base64_encode_to(unsigned char const* bytes_to_encode, size_t in_len, char* out, size_t out_capacity, bool url)
+{
+    if (out_capacity < base64_encoded_size(in_len))
+    {
+        throw std::length_error("base64_encode_to: output buffer too small");
+    }
+
+    return encode_into(bytes_to_encode, in_len, out, url);
+}
+
+size_t base64_encode_to(unsigned char const* bytes_to_encode, size_t in_len, std::string& out, bool url)
+{
+    size_t old_size = out.size();
+    size_t len_encoded = base64_encoded_size(in_len);
+
+    out.resize(old_size + len_encoded);
+    if (len_encoded != 0)
+    {
+        encode_into(bytes_to_encode, in_len, &out[old_size], url);
+    }
+
+    return len_encoded;
+}
+
+size_t base64_encode_to(std::string const& s, std::string& out, bool url)
+{
+    return base64_encode_to(reinterpret_cast<const unsigned char*>(s.data()), s.length(), out, url);
+}
+
+size_t base64_decode_to(char const* encoded, size_t in_len, char* out, size_t out_capacity, base64_skip skip)
+{
+    //
+    // Padding in the third or fourth position of the last chunk does not
+    // produce output, so a buffer of exactly the decoded length is accepted
+    // (when nothing is skipped, otherwise the positions are not known).
+    //
+    size_t needed = decoded_upper_bound(in_len);
+    for (size_t pos = in_len; skip == base64_skip::none && pos > 0 && in_len - pos < 2 && is_padding(encoded[pos - 1]);
+         --pos)
+    {
+        if ((pos - 1) % 4 >= 2) --needed;
+    }
+
+    if (out_capacity < needed)
+    {
+        throw std::length_error("base64_decode_to: output buffer too small");
+    }
+
+    size_t error_pos;
+    size_t written = decode_into(encoded, in_len, reinterpret_cast<unsigned char*>(out),
+                                 static_cast<unsigned int>(skip), error_pos);
+    if (error_pos != no_error)
+    {
+        throw base64_error(error_pos);
+    }
+
+    return written;
+}
+
+size_t base64_decode_to(char const* encoded, size_t in_len, std::string& out, base64_skip skip)
+{
+    size_t old_size = out.size();
+    if (in_len == 0) return 0;
+
+    out.resize(old_size + decoded_upper_bound(in_len));
+
+    size_t error_pos;
+    size_t written = decode_into(encoded, in_len, reinterpret_cast<unsigned char*>(&out[0]) + old_size,
+                                 static_cast<unsigned int>(skip), error_pos);
+    if (error_pos != no_error)
+    {
+        out.resize(old_size);
+        throw base64_error(error_pos);
+    }
+
+    out.resize(old_size + written);
+    return written;
+}
+
+size_t base64_decode_to(std::string const& s, std::string& out, base64_skip skip)
+{
+    return base64_decode_to(s.data(), s.length(), out, skip);
+}
+
+size_t base64_decode_inplace(char* buf, size_t len, base64_skip skip)
+{
+    //
+    // Every chunk is read before its bytes are written, and the output
+    // never gets ahead of the input, so decode_chunks() (and its kernels)
+    // can write over the input. decode_compacted() cannot be used here as
+    // it needs the original input again to locate an error.
+    //
+    size_t error_pos;
+    size_t written = decode_chunks(buf, len, reinterpret_cast<unsigned char*>(buf), static_cast<unsigned int>(skip),
+                                   error_pos);
+    if (error_pos != no_error)
+    {
+        throw base64_error(error_pos);
+    }
+
+    return written;
+}
+
+size_t base64_decode_inplace(std::string& s, base64_skip skip)
+{
+    if (s.empty()) return 0;
+
+    s.resize(base64_decode_inplace(&s[0], s.length(), skip));
+    return s.length();
+}
+
+std::string base64_decode(std::string const& s, bool remove_linebreaks)
+{
+    return decode(s, remove_linebreaks);
+}
+
+std::string base64_decode(std::string const& s, base64_skip skip)
+{
+    return decode(s, static_cast<unsigned int>(skip));
+}
+
+std::string base64_encode(std::string const& s, bool url)
+{
+    return encode(s, url);
+}
+
+std::string base64_encode_pem(std::string const& s, bool crlf)
+{
+    return encode_pem(s, crlf);
+}
+
+std::string base64_encode_mime(std::string const& s, bool crlf)
+{
+    return encode_mime(s, crlf);
+}
+
+base64_encoder::base64_encoder(bool url, size_t line_length, bool crlf)
+    : url_(url), crlf_(crlf), line_length_(line_length), column_(0), pending_(), pending_len_(0)
+{
+}
+
+size_t base64_encoder::update(void const* data, size_t len, std::string& out)
+{
+    const unsigned char* in = static_cast<const unsigned char*>(data);
+
+    if (pending_len_ + len < 3)
+    {
+        std::memcpy(pending_ + pending_len_, in, len);
+        pending_len_ += len;
+        return 0;
+    }
+
+    //
+    // Complete the group started by the previous call, then encode all
+    // complete groups directly from the caller's data.
+    //
+    const size_t head = pending_len_ != 0 ? 3 - pending_len_ : 0;
+    const size_t body = (len - head) / 3 * 3;
+    const size_t old_size = out.size();
+
+    out.resize(old_size + wrapped_length((head != 0 ? 4 : 0) + body / 3 * 4, column_, line_length_, crlf_));
+    char* dst = &out[old_size];
+
+    if (head != 0)
+    {
+        std::memcpy(pending_ + pending_len_, in, head);
+        dst += encode_wrapped_into(pending_, 3, dst, line_length_, crlf_, url_, column_);
+    }
+    encode_wrapped_into(in + head, body, dst, line_length_, crlf_, url_, column_);
+
+    pending_len_ = len - head - body;
+    std::memcpy(pending_, in + head + body, pending_len_);
+
+    return out.size() - old_size;
+}
+
+size_t base64_encoder::finish(std::string& out)
+{
+    const size_t old_size = out.size();
+    if (pending_len_ != 0)
+    {
+        out.resize(old_size + wrapped_length(4, column_, line_length_, crlf_));
+        encode_wrapped_into(pending_, pending_len_, &out[old_size], line_length_, crlf_, url_, column_);
+    }
+
+    reset();
+    return out.size() - old_size;
+}
+
+std::string base64_encoder::update(std::string const& s)
+{
+    std::string ret;
+    update(s.data(), s.length(), ret);
+    return ret;
+}
+
+std::string base64_encoder::finish()
+{
+    std::string ret;
+    finish(ret);
+    return ret;
+}
+
+void base64_encoder::reset()
+{
+    column_ = 0;
+    pending_len_ = 0;
+}
+
+base64_decoder::base64_decoder(base64_skip skip)
+    : skip_(static_cast<unsigned int>(skip)), pending_(), pending_pos_(), pending_len_(0), offset_(0)
+{
+}
+
+size_t base64_decoder::update(char const* encoded, size_t len, std::string& out)
+{
+    const size_t old_size = out.size();
+    size_t pos = 0;
+    size_t written = 0;
+    size_t error_pos;
+
+    //
+    // The held back characters and the new input are at most len + 3
+    // characters, i.e. at most 3 bytes more than the new input alone.
+    //
+    out.resize(old_size + 3 + decoded_upper_bound(len));
+    unsigned char* dst = reinterpret_cast<unsigned char*>(&out[0]) + old_size;
+
+    if (pending_len_ != 0)
+    {
+        //
+        // Complete the chunk held back by the previous call.
+        //
+        char chunk[4];
+        size_t offset[4];
+        size_t chunk_len = pending_len_;
+        std::memcpy(chunk, pending_, pending_len_);
+        std::memcpy(offset, pending_pos_, pending_len_ * sizeof(size_t));
+
+        for (; chunk_len < 4 && pos < len; ++pos)
+        {
+            if (!is_skipped(static_cast<unsigned char>(encoded[pos]), skip_))
+            {
+                chunk[chunk_len] = encoded[pos];
+                offset[chunk_len] = offset_ + pos;
+                ++chunk_len;
+            }
+        }
+
+        if (chunk_len < 4)
+        {
+            std::memcpy(pending_, chunk, chunk_len);
+            std::memcpy(pending_pos_, offset, chunk_len * sizeof(size_t));
+            pending_len_ = chunk_len;
+            offset_ += len;
+            out.resize(old_size);
+            return 0;
+        }
+
+        written = decode_chunks(chunk, 4, dst, 0, error_pos);
+        if (error_pos != no_error)
+        {
+            out.resize(old_size);
+            throw base64_error(offset[error_pos]);
+        }
+        pending_len_ = 0;
+    }
+
+    size_t held_back;
+    written += decode_into(encoded + pos, len - pos, dst + written, skip_, error_pos, &held_back);
+    if (error_pos != no_error)
+    {
+        out.resize(old_size);
+        throw base64_error(offset_ + pos + error_pos);
+    }
+
+    //
+    // The characters of an incomplete last chunk are the last held_back
+    // characters of the input that are not skipped.
+    //
+    for (size_t i = len; held_back != 0;)
+    {
+        --i;
+        if (!is_skipped(static_cast<unsigned char>(encoded[i]), skip_))
+        {
+            --held_back;
+            pending_[held_back] = encoded[i];
+            pending_pos_[held_back] = offset_ + i;
+            ++pending_len_;
+        }
+    }
+
+    offset_ += len;
+    out.resize(old_size + written);
+    return written;
+}
+
+size_t base64_decoder::finish(std::string& out)
+{
+    size_t written = 0;
+    if (pending_len_ != 0)
+    {
+        unsigned char bytes[3];
+        size_t error_pos;
+        written = decode_chunks(pending_, pending_len_, bytes, 0, error_pos);
+        if (error_pos != no_error)
+        {
+            throw base64_error(pending_pos_[error_pos]);
+        }
+        out.append(reinterpret_cast<const char*>(bytes), written);
+    }
+
+    reset();
+    return written;
+}
+
+std::string base64_decoder::update(std::string const& s)
+{
+    std::string ret;
+    update(s.data(), s.length(), ret);
+    return ret;
+}
+
+std::string base64_decoder::finish()
+{
+    std::string ret;
+    finish(ret);
+    return ret;
+}
+
+void base64_decoder::reset()
+{
+    pending_len_ = 0;
+    offset_ = 0;
+}
+
+static unsigned char const* input_data(base64_input const& input)
+{
+    return input.data;
+}
+
+static unsigned char const* input_data(std::string const& input)
+{
+    return reinterpret_cast<const unsigned char*>(input.data());
+}
+
+static size_t input_length(base64_input const& input)
+{
+    return input.len;
+}
+
+static size_t input_length(std::string const& input)
+{
+    return input.length();
+}
+
+template <typename Input>
+static size_t encode_batch(Input const* inputs, size_t count, std::string& out, std::vector<size_t>& offsets, bool url)
+{
+    //
+    // The inputs are copied into a staging block, each padded with zero
+    // bytes to a multiple of 3. Encoding the block in one pass then yields
+    // all encodings back to back, except that the padding characters of
+    // the last group of each input read 'A'; they are fixed per block.
+    // Inputs that do not fit into a block are encoded directly.
+    //
+    static const size_t block_size = 3 * 1024;
+    const char trailing_char = url ? '.' : '=';
+
+    offsets.resize(count + 1);
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        offsets[i] = total;
+        total += base64_encoded_size(input_length(inputs[i]));
+    }
+    offsets[count] = total;
+
+    out.resize(total);
+    if (total == 0) return 0;
+
+    unsigned char block[block_size];
+    size_t filled = 0;
+    size_t first = 0;  // first input in the block
+    char* dst = &out[0];
+
+    const auto flush = [&](size_t end) {
+        encode_into(block, filled, dst + offsets[first], url);
+        for (; first < end; ++first)
+        {
+            const size_t tail = input_length(inputs[first]) % 3;
+            if (tail != 0) std::memset(dst + offsets[first + 1] - (3 - tail), trailing_char, 3 - tail);
+        }
+        filled = 0;
+    };
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const size_t len = input_length(inputs[i]);
+        const size_t padded = (len + 2) / 3 * 3;
+
+        if (filled + padded > block_size)
+        {
+            flush(i);
+            if (padded > block_size)
+            {
+                encode_into(input_data(inputs[i]), len, dst + offsets[i], url);
+                first = i + 1;
+                continue;
+            }
+        }
+
+        std::memcpy(block + filled, input_data(inputs[i]), len);
+        std::memset(block + filled + len, 0, padded - len);
+        filled += padded;
+    }
+    flush(count);
+
+    return total;
+}
+
+size_t base64_encode_batch(base64_input const* inputs, size_t count, std::string& out, std::vector<size_t>& offsets,
+                           bool url)
+{
+    return encode_batch(inputs, count, out, offsets, url);
+}
+
+size_t base64_encode_batch(std::string const* inputs, size_t count, std::string& out, std::vector<size_t>& offsets,
+                           bool url)
+{
+    return encode_batch(inputs, count, out, offsets, url);
+}
+
+//
+// Pieces of a parallel encode/decode are at least this large, so that
+// starting a thread pays off.
+//
+static const size_t parallel_min_piece = 256 * 1024;
+
+static size_t parallel_pieces(size_t in_len, unsigned int threads, size_t threshold)
+{
+    return static_cast<size_t>(parallel::piece_count(in_len, threads, threshold, parallel_min_piece));
+}
+
+std::string base64_encode_parallel(unsigned char const* bytes_to_encode, size_t in_len, bool url, unsigned int threads,
+                                   size_t threshold)
+{
+    const size_t pieces = parallel_pieces(in_len, threads, threshold);
+    if (pieces <= 1) return base64_encode(bytes_to_encode, in_len, url);
+
+    std::string ret(base64_encoded_size(in_len), '\0');
+    char* out = &ret[0];
+
+    //
+    // All pieces but the last one consist of complete 3-byte groups, the
+    // last one includes the padded tail.
+    //
+    const size_t piece_len = (in_len / 3 + pieces - 1) / pieces * 3;
+    parallel::run(pieces, [=](size_t i) {
+        const size_t begin = std::min(in_len, i * piece_len);
+        const size_t end = i + 1 == pieces ? in_len : std::min(in_len, begin + piece_len);
+        encode_into(bytes_to_encode + begin, end - begin, out + begin / 3 * 4, url);
+    });
+
+    return ret;
+}
+
+std::string base64_encode_parallel(std::string const& s, bool url, unsigned int threads, size_t threshold)
+{
+    return base64_encode_parallel(reinterpret_cast<const unsigned char*>(s.data()), s.length(), url, threads,
+                                  threshold);
+}
+
+std::string base64_decode_parallel(char const* encoded, size_t in_len, unsigned int threads, size_t threshold)
+{
+    const size_t pieces = parallel_pieces(in_len, threads, threshold);
+
+    std::string ret(decoded_upper_bound(in_len), '\0');
+    unsigned char* out = in_len != 0 ? reinterpret_cast<unsigned char*>(&ret[0]) : nullptr;
+    size_t error_pos;
+
+    if (pieces <= 1)
+    {
+        ret.resize(decode_into(encoded, in_len, out, 0, error_pos));
+        if (error_pos != no_error)
+        {
+            throw base64_error(error_pos);
+        }
+        return ret;
+    }
+
+    //
+    // Every piece but the last one has to decode to exactly 3 bytes per
+    // 4 characters, otherwise it contains padding (or an invalid
+    // character) and the whole input is decoded again on this thread,
+    // which also finds the offset of the first invalid character.
+    //
+    const size_t piece_len = (in_len / 4 + pieces - 1) / pieces * 4;
+    std::vector<char> failed(pieces, 0);
+    size_t last_written = 0;
+
+    parallel::run(pieces, [&, out](size_t i) {
+        const size_t begin = std::min(in_len, i * piece_len);
+        const size_t end = i + 1 == pieces ? in_len : std::min(in_len, begin + piece_len);
+
+        size_t piece_error;
+        const size_t written = decode_into(encoded + begin, end - begin, out + begin / 4 * 3, 0, piece_error);
+        if (i + 1 == pieces)
+        {
+            last_written = written;
+            failed[i] = piece_error != no_error;
+        }
+        else
+        {
+            failed[i] = piece_error != no_error || written != (end - begin) / 4 * 3;
+        }
+    });
+
+    if (std::find(failed.begin(), failed.end(), 1) != failed.end())
+    {
+        ret.resize(decode_into(encoded, in_len, out, 0, error_pos));
+        if (error_pos != no_error)
+        {
+            throw base64_error(error_pos);
+        }
+        return ret;
+    }
+
+    ret.resize(std::min(in_len, (pieces - 1) * piece_len) / 4 * 3 + last_written);
+    return ret;
+}
+
+std::string base64_decode_parallel(std::string const& s, unsigned int threads, size_t threshold)
+{
+    return base64_decode_parallel(s.data(), s.length(), threads, threshold);
+}
+
+//
+// The files are processed in slices, so that the output buffer stays
+// small (and in cache) even when the whole input is memory-mapped.
+//
+static const size_t file_slice = 3 * 256 * 1024;
+
+bool base64_encode_file(std::string const& in_path, std::string const& out_path, size_t line_length, bool crlf,
+                        bool url)
+{
+    fileio::file_reader reader(in_path);
+    if (!reader.is_open()) return false;
+
+    fileio::file_writer writer(out_path);
+    if (!writer.is_open()) return false;
+
+    base64_encoder encoder(url, line_length, crlf);
+    std::string buffer;
+    buffer.reserve(base64_encoded_size(file_slice + 2, line_length, crlf));
+
+    const unsigned char* data;
+    size_t len;
+    while (reader.next(data, len))
+    {
+        for (size_t pos = 0; pos < len; pos += file_slice)
+        {
+            buffer.clear();
+            encoder.update(data + pos, std::min(file_slice, len - pos), buffer);
+            if (!writer.write(buffer.data(), buffer.size())) return false;
+        }
+    }
+    if (reader.failed()) return false;
+
+    buffer.clear();
+    encoder.finish(buffer);
+    return writer.write(buffer.data(), buffer.size()) && writer.close();
+}
+
+bool base64_decode_file(std::string const& in_path, std::string const& out_path, base64_skip skip)
+{
+    fileio::file_reader reader(in_path);
+    if (!reader.is_open()) return false;
+
+    fileio::file_writer writer(out_path);
+    if (!writer.is_open()) return false;
+
+    base64_decoder decoder(skip);
+    std::string buffer;
+    buffer.reserve(decoded_upper_bound(file_slice) + 3);
+
+    const unsigned char* data;
+    size_t len;
+    while (reader.next(data, len))
+    {
+        for (size_t pos = 0; pos < len; pos += file_slice)
+        {
+            buffer.clear();
+            decoder.update(reinterpret_cast<const char*>(data) + pos, std::min(file_slice, len - pos), buffer);
+            if (!writer.write(buffer.data(), buffer.size())) return false;
+        }
+    }
+    if (reader.failed()) return false;
+
+    buffer.clear();
+    decoder.finish(buffer);
+    return writer.write(buffer.data(), buffer.size()) && writer.close();
+}
+
+#if __cplusplus >= 201703L
+//
+// Interface with std::string_view rather than const std::string&
+// Requires C++17
+// Provided by Yannic Bonenberger (https://github.com/Yannic)
+//
+
+std::string base64_encode(std::string_view s, bool url)
+{
+    return encode(s, url);
+}
+
+std::string base64_encode_pem(std::string_view s, bool crlf)
+{
+    return encode_pem(s, crlf);
+}
+
+std::string base64_encode_mime(std::string_view s, bool crlf)
+{
+    return encode_mime(s, crlf);
+}
+
+std::string base64_decode(std::string_view s, bool remove_linebreaks)
+{
+    return decode(s, remove_linebreaks);
+}
+
+std::string base64_decode(std::string_view s, base64_skip skip)
+{
+    return decode(s, static_cast<unsigned int>(skip));
 }
 #endif  // __cplusplus >= 201703L
 }  // namespace codec
\ No newline at end of file
@@ -0,0 +1,472 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file base64_simd.cpp
+ * @brief base64 的 SSSE3 / AVX2 / AVX-512 VBMI 内核
+ *
+ * 算法参考 Wojciech Muła, Daniel Lemire:
+ *   "Faster Base64 Encoding and Decoding Using AVX2 Instructions"
+ *   "Base64 encoding and decoding at almost the speed of a memory copy"
+ *
+ * 256/512 bit 内核返回 (或转入更窄的内核) 前都执行 vzeroupper, 避免之后的 SSE 代码
+ * 承受 AVX-SSE 状态切换惩罚 (GCC 不会为 target 属性函数自动插入).
+ *
+ * @author abin
+ * @date 2025-12-06
+ */
+
+#include "base64_simd.h"
+
+#include <cstring>
+
+#if UTILS_X86_SIMD
+
+namespace codec
+{
+namespace detail
+{
+namespace
+{
+const char *const kAlphabet[2] = {"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
+                                  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"};
+
+// ---------------- SSSE3 ----------------
+
+// 12 个输入字节 -> 16 个 6 bit 索引 (每个字节一个)
+UTILS_TARGET("ssse3") inline __m128i enc_reshuffle_128(__m128i in)
+{
+  in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+  const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+  const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  return _mm_or_si128(t1, t3);
+}
+
+// 索引 -> 字符的偏移表: [0] 小写, [1..10] 数字, [11] 第 62 个字符, [12] 第 63 个字符, [13] 大写
+UTILS_TARGET("ssse3") inline __m128i enc_offsets_128(bool url)
+{
+  const char c62 = url ? '-' : '+';
+  const char c63 = url ? '_' : '/';
+  return _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                       '0' - 52, '0' - 52, static_cast<char>(c62 - 62), static_cast<char>(c63 - 63), 'A', 0, 0);
+}
+
+UTILS_TARGET("ssse3") inline __m128i enc_translate_128(__m128i indices, __m128i offsets)
+{
+  __m128i result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  result = _mm_or_si128(result, _mm_and_si128(less, _mm_set1_epi8(13)));
+  return _mm_add_epi8(_mm_shuffle_epi8(offsets, result), indices);
+}
+
+// ---------------- AVX2 ----------------
+
+UTILS_TARGET("avx2") inline __m256i enc_reshuffle_256(__m256i in)
+{
+  in = _mm256_shuffle_epi8(in, _mm256_broadcastsi128_si256(
+                                 _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1)));
+  const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+  const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+  const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+  const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+  return _mm256_or_si256(t1, t3);
+}
+
+UTILS_TARGET("avx2") inline __m256i enc_translate_256(__m256i indices, __m256i offsets)
+{
+  __m256i result = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+  const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+  result = _mm256_or_si256(result, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+  return _mm256_add_epi8(_mm256_shuffle_epi8(offsets, result), indices);
+}
+
+// ---------------- 解码: 字符校验与翻译 ----------------
+//
+// 合法字符按高 4 bit 分类, lut_hi 给出类别位, lut_lo 给出该低 4 bit 下不合法的类别集合,
+// 两者相与非零即表示存在非法字符. 高 4 bit 为 0/1/8..F 的字节 (含所有非 ASCII 字节) 一律不合法.
+//
+//   hi=2: '+' '-' '/'    hi=3: '0'..'9'    hi=4/6: 'A'..'O' / 'a'..'o'
+//   hi=5: 'P'..'Z' '_'   hi=7: 'p'..'z'
+//
+// 翻译时按高 4 bit 取偏移, 再单独修正 '-' '/' '_' 三个字符.
+
+#define UTILS_B64_LUT_LO \
+  0x25, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x23, 0x3a, 0x3b, 0x3a, 0x3b, 0x32
+#define UTILS_B64_LUT_HI \
+  0x20, 0x20, 0x01, 0x02, 0x04, 0x08, 0x04, 0x10, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20
+#define UTILS_B64_LUT_ROLL 0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+
+// 返回 16 个 6 bit 值; 存在非法字符时返回 false
+UTILS_TARGET("ssse3") inline bool dec_translate_128(__m128i in, __m128i &values)
+{
+  const __m128i lut_lo = _mm_setr_epi8(UTILS_B64_LUT_LO);
+  const __m128i lut_hi = _mm_setr_epi8(UTILS_B64_LUT_HI);
+  const __m128i lut_roll = _mm_setr_epi8(UTILS_B64_LUT_ROLL);
+  const __m128i nibble = _mm_set1_epi8(0x0f);
+
+  const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(in, 4), nibble);
+  const __m128i lo_nibbles = _mm_and_si128(in, nibble);
+  const __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+  const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0xffff) return false;
+
+  __m128i roll = _mm_shuffle_epi8(lut_roll, hi_nibbles);
+  roll = _mm_add_epi8(roll, _mm_and_si128(_mm_cmpeq_epi8(in, _mm_set1_epi8('-')), _mm_set1_epi8(-2)));
+  roll = _mm_add_epi8(roll, _mm_and_si128(_mm_cmpeq_epi8(in, _mm_set1_epi8('/')), _mm_set1_epi8(-3)));
+  roll = _mm_add_epi8(roll, _mm_and_si128(_mm_cmpeq_epi8(in, _mm_set1_epi8('_')), _mm_set1_epi8(33)));
+  values = _mm_add_epi8(in, roll);
+  return true;
+}
+
+// 16 个 6 bit 值 -> 每个 32 bit 通道低 24 bit 为 3 个输出字节 (大端顺序待重排)
+UTILS_TARGET("ssse3") inline __m128i dec_pack_128(__m128i values)
+{
+  const __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+  const __m128i packed = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+  return _mm_shuffle_epi8(packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+UTILS_TARGET("avx2") inline bool dec_translate_256(__m256i in, __m256i &values)
+{
+  const __m256i lut_lo = _mm256_setr_epi8(UTILS_B64_LUT_LO, UTILS_B64_LUT_LO);
+  const __m256i lut_hi = _mm256_setr_epi8(UTILS_B64_LUT_HI, UTILS_B64_LUT_HI);
+  const __m256i lut_roll = _mm256_setr_epi8(UTILS_B64_LUT_ROLL, UTILS_B64_LUT_ROLL);
+  const __m256i nibble = _mm256_set1_epi8(0x0f);
+
+  const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), nibble);
+  const __m256i lo_nibbles = _mm256_and_si256(in, nibble);
+  const __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+  const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+  if (!_mm256_testz_si256(lo, hi)) return false;
+
+  __m256i roll = _mm256_shuffle_epi8(lut_roll, hi_nibbles);
+  roll = _mm256_add_epi8(roll, _mm256_and_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('-')), _mm256_set1_epi8(-2)));
+  roll = _mm256_add_epi8(roll, _mm256_and_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('/')), _mm256_set1_epi8(-3)));
+  roll = _mm256_add_epi8(roll, _mm256_and_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('_')), _mm256_set1_epi8(33)));
+  values = _mm256_add_epi8(in, roll);
+  return true;
+}
+
+UTILS_TARGET("avx2") inline __m256i dec_pack_256(__m256i values)
+{
+  const __m256i merged = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+  const __m256i packed = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+  const __m256i shuffled = _mm256_shuffle_epi8(
+    packed, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14,
+                             13, 12, -1, -1, -1, -1));
+  // 两个通道各 12 字节 -> 连续的 24 字节
+  return _mm256_permutevar8x32_epi32(shuffled, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+}
+
+// 只做校验: 非法字符对应的字节非零
+UTILS_TARGET("ssse3") inline __m128i dec_invalid_128(__m128i in)
+{
+  const __m128i lut_lo = _mm_setr_epi8(UTILS_B64_LUT_LO);
+  const __m128i lut_hi = _mm_setr_epi8(UTILS_B64_LUT_HI);
+  const __m128i nibble = _mm_set1_epi8(0x0f);
+  const __m128i lo = _mm_shuffle_epi8(lut_lo, _mm_and_si128(in, nibble));
+  const __m128i hi = _mm_shuffle_epi8(lut_hi, _mm_and_si128(_mm_srli_epi32(in, 4), nibble));
+  return _mm_and_si128(lo, hi);
+}
+
+UTILS_TARGET("avx2") inline __m256i dec_invalid_256(__m256i in)
+{
+  const __m256i lut_lo = _mm256_setr_epi8(UTILS_B64_LUT_LO, UTILS_B64_LUT_LO);
+  const __m256i lut_hi = _mm256_setr_epi8(UTILS_B64_LUT_HI, UTILS_B64_LUT_HI);
+  const __m256i nibble = _mm256_set1_epi8(0x0f);
+  const __m256i lo = _mm256_shuffle_epi8(lut_lo, _mm256_and_si256(in, nibble));
+  const __m256i hi = _mm256_shuffle_epi8(lut_hi, _mm256_and_si256(_mm256_srli_epi32(in, 4), nibble));
+  return _mm256_and_si256(lo, hi);
+}
+
+UTILS_TARGET("avx512f,avx512bw") inline __mmask64 dec_invalid_512(__m512i in)
+{
+  const __m512i lut_lo = _mm512_broadcast_i32x4(_mm_setr_epi8(UTILS_B64_LUT_LO));
+  const __m512i lut_hi = _mm512_broadcast_i32x4(_mm_setr_epi8(UTILS_B64_LUT_HI));
+  const __m512i nibble = _mm512_set1_epi8(0x0f);
+  const __m512i lo = _mm512_shuffle_epi8(lut_lo, _mm512_and_si512(in, nibble));
+  const __m512i hi = _mm512_shuffle_epi8(lut_hi, _mm512_and_si512(_mm512_srli_epi32(in, 4), nibble));
+  return _mm512_test_epi8_mask(lo, hi);
+}
+
+#undef UTILS_B64_LUT_LO
+#undef UTILS_B64_LUT_HI
+#undef UTILS_B64_LUT_ROLL
+
+// AVX-512 VBMI 解码用的 128 项 ASCII 翻译表, 0x80 表示非法字符
+alignas(64) const unsigned char kDecodeTable[128] = {
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x3e, 0x80, 0x3e, 0x80, 0x3f,
+  0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  0x80, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+  0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x80, 0x80, 0x80, 0x80, 0x3f,
+  0x80, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+  0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+// ---------------- 解码前去除空白 ----------------
+
+// 8 字节中按掩码 (1 表示丢弃) 保留的字节下标, 依次排在前面
+struct compaction_table
+{
+  unsigned char shuffle[256][8];
+  unsigned char count[256];
+
+  compaction_table() : shuffle(), count()
+  {
+    for (unsigned int mask = 0; mask < 256; ++mask)
+    {
+      unsigned char n = 0;
+      for (unsigned char i = 0; i < 8; ++i)
+      {
+        if (((mask >> i) & 1) == 0) shuffle[mask][n++] = i;
+      }
+      count[mask] = n;
+    }
+  }
+};
+
+const compaction_table &compaction()
+{
+  static const compaction_table table;
+  return table;
+}
+}  // namespace
+
+UTILS_TARGET("ssse3") size_t base64_encode_ssse3(unsigned char const *in, size_t len, char *out, bool url)
+{
+  const __m128i offsets = enc_offsets_128(url);
+  size_t pos = 0;
+  // 每次读 16 字节, 只使用前 12 字节
+  while (len - pos >= 16)
+  {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + pos));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), enc_translate_128(enc_reshuffle_128(v), offsets));
+    out += 16;
+    pos += 12;
+  }
+  return pos;
+}
+
+UTILS_TARGET("avx2") size_t base64_encode_avx2(unsigned char const *in, size_t len, char *out, bool url)
+{
+  const __m256i offsets = _mm256_broadcastsi128_si256(enc_offsets_128(url));
+  size_t pos = 0;
+  // 每个 128 bit 通道各处理 12 字节, 高通道从 in + 12 处读取
+  while (len - pos >= 28)
+  {
+    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + pos));
+    const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + pos + 12));
+    const __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), enc_translate_256(enc_reshuffle_256(v), offsets));
+    out += 32;
+    pos += 24;
+  }
+  _mm256_zeroupper();
+  return pos + base64_encode_ssse3(in + pos, len - pos, out, url);
+}
+
+UTILS_TARGET("avx512f,avx512bw,avx512vbmi")
+size_t base64_encode_avx512vbmi(unsigned char const *in, size_t len, char *out, bool url)
+{
+  // 每个 32 bit 输出组取输入字节 [3j+1, 3j, 3j+2, 3j+1], 再用 multishift 取出 4 个 6 bit 字段
+  const __m512i shuffle_input = _mm512_setr_epi32(0x01020001, 0x04050304, 0x07080607, 0x0a0b090a, 0x0d0e0c0d,
+                                                  0x10110f10, 0x13141213, 0x16171516, 0x191a1819, 0x1c1d1b1c,
+                                                  0x1f201e1f, 0x22232122, 0x25262425, 0x28292728, 0x2b2c2a2b,
+                                                  0x2e2f2d2e);
+  const __m512i shifts = _mm512_set1_epi64(0x3036242a1016040a);
+  const __m512i lookup = _mm512_loadu_si512(kAlphabet[url]);
+  size_t pos = 0;
+  // 每次读 64 字节, 只使用前 48 字节
+  while (len - pos >= 64)
+  {
+    const __m512i v = _mm512_loadu_si512(in + pos);
+    const __m512i grouped = _mm512_permutexvar_epi8(shuffle_input, v);
+    const __m512i indices = _mm512_multishift_epi64_epi8(shifts, grouped);
+    _mm512_storeu_si512(out, _mm512_permutexvar_epi8(indices, lookup));
+    out += 64;
+    pos += 48;
+  }
+  _mm256_zeroupper();
+  return pos + base64_encode_avx2(in + pos, len - pos, out, url);
+}
+
+UTILS_TARGET("ssse3") size_t base64_decode_ssse3(char const *in, size_t len, unsigned char *out)
+{
+  size_t pos = 0;
+  while (len - pos >= 16)
+  {
+    __m128i values;
+    if (!dec_translate_128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + pos)), values)) break;
+    const __m128i bytes = dec_pack_128(values);
+    // 只写 12 个有效字节, 不越过输出末尾
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(out), bytes);
+    const int tail = _mm_cvtsi128_si32(_mm_srli_si128(bytes, 8));
+    std::memcpy(out + 8, &tail, 4);
+    out += 12;
+    pos += 16;
+  }
+  return pos;
+}
+
+UTILS_TARGET("avx2") size_t base64_decode_avx2(char const *in, size_t len, unsigned char *out)
+{
+  size_t pos = 0;
+  while (len - pos >= 32)
+  {
+    __m256i values;
+    if (!dec_translate_256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + pos)), values)) break;
+    const __m256i bytes = dec_pack_256(values);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm256_castsi256_si128(bytes));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(out + 16), _mm256_extracti128_si256(bytes, 1));
+    out += 24;
+    pos += 32;
+  }
+  _mm256_zeroupper();
+  return pos + base64_decode_ssse3(in + pos, len - pos, out);
+}
+
+UTILS_TARGET("avx512f,avx512bw,avx512vbmi")
+size_t base64_decode_avx512vbmi(char const *in, size_t len, unsigned char *out)
+{
+  const __m512i table_lo = _mm512_load_si512(kDecodeTable);
+  const __m512i table_hi = _mm512_load_si512(kDecodeTable + 64);
+  // 每个 32 bit 通道的低 3 字节按大端顺序排到输出的前 48 字节
+  const __m512i compact = _mm512_setr_epi32(0x06000102, 0x090a0405, 0x0c0d0e08, 0x16101112, 0x191a1415, 0x1c1d1e18,
+                                            0x26202122, 0x292a2425, 0x2c2d2e28, 0x36303132, 0x393a3435, 0x3c3d3e38,
+                                            0, 0, 0, 0);
+  const __mmask64 store_mask = 0x0000ffffffffffffULL;
+  size_t pos = 0;
+  while (len - pos >= 64)
+  {
+    const __m512i v = _mm512_loadu_si512(in + pos);
+    const __m512i values = _mm512_permutex2var_epi8(table_lo, v, table_hi);
+    // 输入为非 ASCII 或查表结果为 0x80 时最高位置 1
+    if (_mm512_movepi8_mask(_mm512_or_si512(v, values)) != 0) break;
+    const __m512i merged = _mm512_maddubs_epi16(values, _mm512_set1_epi32(0x01400140));
+    const __m512i packed = _mm512_madd_epi16(merged, _mm512_set1_epi32(0x00011000));
+    _mm512_mask_storeu_epi8(out, store_mask, _mm512_permutexvar_epi8(compact, packed));
+    out += 48;
+    pos += 64;
+  }
+  _mm256_zeroupper();
+  return pos + base64_decode_avx2(in + pos, len - pos, out);
+}
+
+UTILS_TARGET("ssse3") size_t base64_validate_ssse3(char const *in, size_t len)
+{
+  const __m128i zero = _mm_setzero_si128();
+  size_t pos = 0;
+  // 每次检查 64 字节, 出现非法字符后再按 16 字节定位到块
+  while (len - pos >= 64)
+  {
+    const __m128i *p = reinterpret_cast<const __m128i *>(in + pos);
+    const __m128i bad01 = _mm_or_si128(dec_invalid_128(_mm_loadu_si128(p)), dec_invalid_128(_mm_loadu_si128(p + 1)));
+    const __m128i bad23 =
+      _mm_or_si128(dec_invalid_128(_mm_loadu_si128(p + 2)), dec_invalid_128(_mm_loadu_si128(p + 3)));
+    const __m128i bad = _mm_or_si128(bad01, bad23);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(bad, zero)) != 0xffff) break;
+    pos += 64;
+  }
+  while (len - pos >= 16)
+  {
+    const __m128i bad = dec_invalid_128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + pos)));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(bad, zero)) != 0xffff) break;
+    pos += 16;
+  }
+  return pos;
+}
+
+UTILS_TARGET("avx2") size_t base64_validate_avx2(char const *in, size_t len)
+{
+  size_t pos = 0;
+  while (len - pos >= 128)
+  {
+    const __m256i *p = reinterpret_cast<const __m256i *>(in + pos);
+    const __m256i bad01 =
+      _mm256_or_si256(dec_invalid_256(_mm256_loadu_si256(p)), dec_invalid_256(_mm256_loadu_si256(p + 1)));
+    const __m256i bad23 =
+      _mm256_or_si256(dec_invalid_256(_mm256_loadu_si256(p + 2)), dec_invalid_256(_mm256_loadu_si256(p + 3)));
+    const __m256i bad = _mm256_or_si256(bad01, bad23);
+    if (!_mm256_testz_si256(bad, bad)) break;
+    pos += 128;
+  }
+  while (len - pos >= 32)
+  {
+    const __m256i bad = dec_invalid_256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + pos)));
+    if (!_mm256_testz_si256(bad, bad)) break;
+    pos += 32;
+  }
+  _mm256_zeroupper();
+  return pos + base64_validate_ssse3(in + pos, len - pos);
+}
+
+UTILS_TARGET("avx512f,avx512bw") size_t base64_validate_avx512bw(char const *in, size_t len)
+{
+  size_t pos = 0;
+  while (len - pos >= 256)
+  {
+    const __mmask64 bad =
+      dec_invalid_512(_mm512_loadu_si512(in + pos)) | dec_invalid_512(_mm512_loadu_si512(in + pos + 64)) |
+      dec_invalid_512(_mm512_loadu_si512(in + pos + 128)) | dec_invalid_512(_mm512_loadu_si512(in + pos + 192));
+    if (bad != 0) break;
+    pos += 256;
+  }
+  while (len - pos >= 64)
+  {
+    if (dec_invalid_512(_mm512_loadu_si512(in + pos)) != 0) break;
+    pos += 64;
+  }
+  _mm256_zeroupper();
+  return pos + base64_validate_avx2(in + pos, len - pos);
+}
+
+UTILS_TARGET("ssse3")
+size_t base64_compact_ssse3(char const *in, size_t len, char *out, size_t out_capacity, char const set[4],
+                            size_t &consumed)
+{
+  const compaction_table &table = compaction();
+  const __m128i c0 = _mm_set1_epi8(set[0]);
+  const __m128i c1 = _mm_set1_epi8(set[1]);
+  const __m128i c2 = _mm_set1_epi8(set[2]);
+  const __m128i c3 = _mm_set1_epi8(set[3]);
+  const __m128i eight = _mm_set1_epi8(8);
+  size_t pos = 0;
+  size_t written = 0;
+  while (len - pos >= 16 && out_capacity - written >= 16)
+  {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + pos));
+    const __m128i eq = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, c0), _mm_cmpeq_epi8(v, c1)),
+                                    _mm_or_si128(_mm_cmpeq_epi8(v, c2), _mm_cmpeq_epi8(v, c3)));
+    const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(eq));
+    if (mask == 0)
+    {
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + written), v);
+      written += 16;
+    }
+    else
+    {
+      // 两个 8 字节半区分别查表压紧
+      const unsigned int lo = mask & 0xff;
+      const unsigned int hi = mask >> 8;
+      const __m128i shuffle_lo = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(table.shuffle[lo]));
+      const __m128i shuffle_hi =
+        _mm_add_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(table.shuffle[hi])), eight);
+      _mm_storel_epi64(reinterpret_cast<__m128i *>(out + written), _mm_shuffle_epi8(v, shuffle_lo));
+      written += table.count[lo];
+      _mm_storel_epi64(reinterpret_cast<__m128i *>(out + written), _mm_shuffle_epi8(v, shuffle_hi));
+      written += table.count[hi];
+    }
+    pos += 16;
+  }
+  consumed = pos;
+  return written;
+}
+
+}  // namespace detail
+}  // namespace codec
+
+#endif  // UTILS_X86_SIMD
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file base64_simd.h
+ * @brief base64 向量化内核（库内部使用，由 base64.cpp 在运行时按 CPU 特性分派）
+ *
+ * 内核只处理输入中能整块处理的前缀, 返回已消耗的输入字节数,
+ * 剩余的尾部由 base64.cpp 中的标量代码完成。
+ *
+ * @author abin
+ * @date 2025-12-06
+ */
+
+#ifndef __GUARD_BASE64_SIMD_H_INCLUDE_GUARD__
+#define __GUARD_BASE64_SIMD_H_INCLUDE_GUARD__
+
+#include <cstddef>
+
+#include "cpu_features.h"
+
+namespace codec
+{
+namespace detail
+{
+
+// 编码内核: 消耗 3 的整数倍个输入字节, 向 out 写入 consumed / 3 * 4 个字符
+using base64_encode_kernel = size_t (*)(unsigned char const *in, size_t len, char *out, bool url);
+
+// 解码内核: 只处理完全由 base64 字符 (含 '+' '-' '/' '_') 组成的整块输入,
+// 遇到包含其它字符 (填充、空白、非法字符) 的块即停止并返回, 由标量代码接手定位.
+// 返回已消耗的输入字符数 (4 的倍数), 向 out 恰好写入 consumed / 4 * 3 个字节.
+// 每块都先读入再写出, 且输出位置不超过输入位置, 因此 out 可以与 in 指向同一缓冲区.
+using base64_decode_kernel = size_t (*)(char const *in, size_t len, unsigned char *out);
+
+// 校验内核: 返回开头完全由 base64 字符组成的整块的总长度, 判定与解码内核相同.
+using base64_validate_kernel = size_t (*)(char const *in, size_t len);
+
+#if UTILS_X86_SIMD
+size_t base64_encode_ssse3(unsigned char const *in, size_t len, char *out, bool url);
+size_t base64_encode_avx2(unsigned char const *in, size_t len, char *out, bool url);
+size_t base64_encode_avx512vbmi(unsigned char const *in, size_t len, char *out, bool url);
+
+size_t base64_decode_ssse3(char const *in, size_t len, unsigned char *out);
+size_t base64_decode_avx2(char const *in, size_t len, unsigned char *out);
+size_t base64_decode_avx512vbmi(char const *in, size_t len, unsigned char *out);
+
+size_t base64_validate_ssse3(char const *in, size_t len);
+size_t base64_validate_avx2(char const *in, size_t len);
+size_t base64_validate_avx512bw(char const *in, size_t len);
+
+// 把 in 中不等于 set[0..3] 的字符紧凑地复制到 out (解码时跳过空白), 返回写入的字节数,
+// consumed 为已处理的输入字节数. 每次处理 16 字节, out 需保留至少 16 字节的余量.
+size_t base64_compact_ssse3(char const *in, size_t len, char *out, size_t out_capacity, char const set[4],
+                            size_t &consumed);
+#endif  // UTILS_X86_SIMD
+
+}  // namespace detail
+}  // namespace codec
+
+#endif  // __GUARD_BASE64_SIMD_H_INCLUDE_GUARD__
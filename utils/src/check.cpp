@@ -1,7 +1,13 @@
 #include "utils/check.h"
 
-#include <array>
-#include <fstream>
+#include <algorithm>
+#include <vector>
+
+#include "checksum_simd.h"
+#include "crc_simd.h"
+#include "file_io.h"
+#include "parallel.h"
+#include "utils/crc.h"
 
 namespace checkutils
 {
@@ -9,269 +15,651 @@ namespace checkutils
 // ---------------- 内部工具函数 ----------------
 namespace
 {
-constexpr std::size_t BUFFER_SIZE = 8192;
-using Buffer = std::array<char, BUFFER_SIZE>;
+// 整个文件送入 hasher, 文件打开或读取失败时返回 0
+template <typename Hasher>
+auto hash_file(const std::string &filepath, size_t buffer_size, Hasher hasher) -> decltype(hasher.value())
+{
+  fileio::file_reader file(filepath, buffer_size);
+  if (!file.is_open()) return {};
+
+  const unsigned char *data = nullptr;
+  size_t len = 0;
+  while (file.next(data, len)) hasher.update(data, len);
+  if (file.failed()) return {};
+  return hasher.value();
+}
 
-Buffer make_buffer()
+template <typename Hasher>
+auto hash_file(const std::string &filepath, size_t buffer_size) -> decltype(Hasher().value())
 {
-  return {};
+  return hash_file(filepath, buffer_size, Hasher());
 }
 
-std::ifstream open_file(const std::string &filepath)
+template <typename Hasher>
+auto hash_string(const std::string &data) -> decltype(Hasher().value())
 {
-  return std::ifstream(filepath, std::ios::binary);
+  Hasher hasher;
+  hasher.update(data.data(), data.size());
+  return hasher.value();
 }
-}  // namespace
 
-// ---------------- CRC8 ----------------
-static uint8_t crc8_update(uint8_t crc, const unsigned char *buf, size_t len)
+const unsigned char *bytes(const void *data)
 {
-  while ((len--) != 0U)
+  return static_cast<const unsigned char *>(data);
+}
+
+// ---------------- CRC 合并 ----------------
+// 反射域中的 a * b mod P (最高位为 x^0)
+template <uint32_t Poly>
+uint32_t multmodp(uint32_t a, uint32_t b)
+{
+  uint32_t product = 0;
+  for (uint32_t m = 1U << 31; m != 0; m >>= 1)
   {
-    crc ^= *buf++;
-    for (int i = 0; i < 8; ++i) crc = ((crc & 0x80) != 0) ? (crc << 1) ^ 0x07 : (crc << 1);
+    if ((a & m) != 0) product ^= b;
+    b = (b & 1) != 0 ? (b >> 1) ^ Poly : b >> 1;
   }
-  return crc;
+  return product;
 }
 
-uint8_t crc8(const std::string &data)
+// x^(8 * len) mod P, 逐次平方
+template <uint32_t Poly>
+uint32_t x8nmodp(uint64_t len)
 {
-  return crc8_update(0x00, reinterpret_cast<const unsigned char *>(data.c_str()), data.size());
+  uint32_t power = 1U << (31 - 8);  // x^8
+  uint32_t result = 1U << 31;       // x^0
+  for (; len != 0; len >>= 1)
+  {
+    if ((len & 1) != 0) result = multmodp<Poly>(power, result);
+    power = multmodp<Poly>(power, power);
+  }
+  return result;
 }
 
-uint8_t crc8_file(const std::string &filepath)
+// 前一段的 CRC 相当于其后再跟 len2 个零字节, 与后一段的 CRC 线性叠加
+template <uint32_t Poly>
+uint32_t crc_combine(uint32_t crc1, uint32_t crc2, uint64_t len2)
 {
-  auto file = open_file(filepath);
-  if (!file) return 0;
+  return multmodp<Poly>(x8nmodp<Poly>(len2), crc1) ^ crc2;
+}
 
-  uint8_t crc = 0x00;
-  auto buffer = make_buffer();
-  while (file.good())
+// ---------------- 多线程计算文件 ----------------
+// 计算文件 [begin, end) 范围的 CRC, 读取失败 (含文件被截短) 时返回 false
+template <typename Hasher>
+bool hash_file_range(const std::string &filepath, uint64_t begin, uint64_t end, uint32_t &crc)
+{
+  fileio::file_reader file(filepath, 0, begin, end - begin);
+  if (!file.is_open()) return false;
+
+  Hasher hasher;
+  uint64_t total = 0;
+  const unsigned char *data = nullptr;
+  size_t len = 0;
+  while (file.next(data, len))
   {
-    file.read(buffer.data(), buffer.size());
-    crc = crc8_update(crc, reinterpret_cast<const unsigned char *>(buffer.data()), file.gcount());
+    hasher.update(data, len);
+    total += len;
   }
-  return crc;
+  crc = hasher.value();
+  return !file.failed() && total == end - begin;
 }
 
-// ---------------- CRC16 ----------------
-static uint16_t crc16_update(uint16_t crc, const unsigned char *buf, size_t len)
+template <typename Hasher, uint32_t Poly>
+uint32_t hash_file_parallel(const std::string &filepath, unsigned int threads, uint64_t threshold)
 {
-  while ((len--) != 0U)
+  // 每段不小于 min_piece, 使启动线程的开销可以忽略
+  static const uint64_t min_piece = 1024 * 1024;
+
+  uint64_t size = 0;
+  if (!fileio::file_size(filepath, size)) return 0;
+
+  const uint64_t pieces = parallel::piece_count(size, threads, threshold, min_piece);
+  if (pieces <= 1) return hash_file<Hasher>(filepath, 0);
+
+  const uint64_t piece_len = (size + pieces - 1) / pieces;
+  std::vector<uint32_t> crcs(static_cast<size_t>(pieces));
+  std::vector<char> piece_ok(static_cast<size_t>(pieces));
+  parallel::run(static_cast<size_t>(pieces), [&](size_t i) {
+    const uint64_t begin = std::min(size, i * piece_len);
+    const uint64_t end = std::min(size, begin + piece_len);
+    piece_ok[i] = hash_file_range<Hasher>(filepath, begin, end, crcs[i]);
+  });
+
+  uint32_t crc = crcs[0];
+  for (size_t i = 0; i < crcs.size(); ++i)
   {
-    crc ^= *buf++;
-    for (int i = 0; i < 8; i++) crc = ((crc & 1) != 0) ? (crc >> 1) ^ 0xA001 : (crc >> 1);
+    if (piece_ok[i] == 0) return 0;
+    if (i != 0) crc = crc_combine<Poly>(crc, crcs[i], std::min(size, (i + 1) * piece_len) - i * piece_len);
   }
   return crc;
 }
+}  // namespace
 
-uint16_t crc16(const std::string &data)
+// ---------------- CRC8 ----------------
+// CRC-8/SMBUS: 多项式 0x07, 非反射
+static uint8_t crc8_update(uint8_t crc, const unsigned char *buf, size_t len)
 {
-  return crc16_update(0xFFFF, reinterpret_cast<const unsigned char *>(data.c_str()), data.size());
+  return crc_catalog::crc8_smbus::extend(crc, buf, len);
 }
 
-uint16_t crc16_file(const std::string &filepath)
+void crc8_hasher::update(const void *data, size_t len)
 {
-  auto file = open_file(filepath);
-  if (!file) return 0;
+  crc_ = crc8_update(crc_, bytes(data), len);
+}
 
-  uint16_t crc = 0xFFFF;
-  auto buffer = make_buffer();
-  while (file.good())
-  {
-    file.read(buffer.data(), buffer.size());
-    crc = crc16_update(crc, reinterpret_cast<const unsigned char *>(buffer.data()), file.gcount());
-  }
-  return crc;
+uint8_t crc8(const std::string &data)
+{
+  return hash_string<crc8_hasher>(data);
+}
+
+uint8_t crc8_file(const std::string &filepath, size_t buffer_size)
+{
+  return hash_file<crc8_hasher>(filepath, buffer_size);
+}
+
+// ---------------- CRC16 ----------------
+// CRC-16/MODBUS: 多项式 0x8005, 反射
+static uint16_t crc16_update(uint16_t crc, const unsigned char *buf, size_t len)
+{
+  return crc_catalog::crc16_modbus::extend(crc, buf, len);
+}
+
+void crc16_hasher::update(const void *data, size_t len)
+{
+  crc_ = crc16_update(crc_, bytes(data), len);
+}
+
+uint16_t crc16(const std::string &data)
+{
+  return hash_string<crc16_hasher>(data);
+}
+
+uint16_t crc16_file(const std::string &filepath, size_t buffer_size)
+{
+  return hash_file<crc16_hasher>(filepath, buffer_size);
 }
 
 // ---------------- CRC32 ----------------
+static detail::crc32_kernel select_crc32_kernel()
+{
+#if UTILS_X86_SIMD
+  const cpu::feature_set &f = cpu::features();
+  if (f.pclmul && f.sse41) return detail::crc32_pclmul;
+#endif  // UTILS_X86_SIMD
+  return nullptr;
+}
+
+// CRC-32/ISO-HDLC: 多项式 0x04C11DB7, 反射
 static uint32_t crc32_update(uint32_t crc, const unsigned char *buf, size_t len)
 {
-  crc = ~crc;
-  while ((len--) != 0U)
+  static const detail::crc32_kernel kernel = select_crc32_kernel();
+
+  uint32_t reg = ~crc;
+  if (kernel != nullptr)
   {
-    crc ^= *buf++;
-    for (int i = 0; i < 8; i++) crc = ((crc & 1) != 0) ? (crc >> 1) ^ 0xEDB88320 : (crc >> 1);
+    const size_t done = kernel(reg, buf, len);
+    buf += done;
+    len -= done;
   }
-  return ~crc;
+  return crc_catalog::crc32_iso_hdlc::extend(~reg, buf, len);
+}
+
+void crc32_hasher::update(const void *data, size_t len)
+{
+  crc_ = crc32_update(crc_, bytes(data), len);
 }
 
 uint32_t crc32(const std::string &data)
 {
-  return crc32_update(0, reinterpret_cast<const unsigned char *>(data.c_str()), data.size());
+  return hash_string<crc32_hasher>(data);
+}
+
+uint32_t crc32_file(const std::string &filepath, size_t buffer_size)
+{
+  return hash_file<crc32_hasher>(filepath, buffer_size);
+}
+
+uint32_t crc32_combine(uint32_t crc1, uint32_t crc2, uint64_t len2)
+{
+  return crc_combine<0xEDB88320>(crc1, crc2, len2);
+}
+
+uint32_t crc32_file_parallel(const std::string &filepath, unsigned int threads, uint64_t threshold)
+{
+  return hash_file_parallel<crc32_hasher, 0xEDB88320>(filepath, threads, threshold);
+}
+
+// ---------------- CRC32C ----------------
+static detail::crc32_kernel select_crc32c_kernel()
+{
+#if UTILS_X86_SIMD
+  const cpu::feature_set &f = cpu::features();
+  if (f.sse42 && f.pclmul) return detail::crc32c_sse42_pclmul;
+  if (f.sse42) return detail::crc32c_sse42;
+#endif  // UTILS_X86_SIMD
+  return nullptr;
 }
 
-uint32_t crc32_file(const std::string &filepath)
+// CRC-32/ISCSI: 多项式 0x1EDC6F41, 反射
+static uint32_t crc32c_update(uint32_t crc, const unsigned char *buf, size_t len)
 {
-  auto file = open_file(filepath);
-  if (!file) return 0;
+  static const detail::crc32_kernel kernel = select_crc32c_kernel();
 
-  uint32_t crc = 0;
-  auto buffer = make_buffer();
-  while (file.good())
+  uint32_t reg = ~crc;
+  if (kernel != nullptr)
   {
-    file.read(buffer.data(), buffer.size());
-    crc = crc32_update(crc, reinterpret_cast<const unsigned char *>(buffer.data()), file.gcount());
+    const size_t done = kernel(reg, buf, len);
+    buf += done;
+    len -= done;
   }
-  return crc;
+  return crc_catalog::crc32_iscsi::extend(~reg, buf, len);
 }
 
-// ---------------- 和校验 ----------------
-uint8_t sum8(const std::string &data)
+void crc32c_hasher::update(const void *data, size_t len)
+{
+  crc_ = crc32c_update(crc_, bytes(data), len);
+}
+
+uint32_t crc32c(const std::string &data)
+{
+  return hash_string<crc32c_hasher>(data);
+}
+
+uint32_t crc32c_file(const std::string &filepath, size_t buffer_size)
+{
+  return hash_file<crc32c_hasher>(filepath, buffer_size);
+}
+
+uint32_t crc32c_combine(uint32_t crc1, uint32_t crc2, uint64_t len2)
+{
+  return crc_combine<0x82F63B78>(crc1, crc2, len2);
+}
+
+uint32_t crc32c_file_parallel(const std::string &filepath, unsigned int threads, uint64_t threshold)
 {
-  uint16_t sum = 0;
-  for (auto c : data) sum += static_cast<uint8_t>(c);
-  return static_cast<uint8_t>(sum & 0xFF);
+  return hash_file_parallel<crc32c_hasher, 0x82F63B78>(filepath, threads, threshold);
 }
 
-uint8_t sum8_file(const std::string &filepath)
+// ---------------- CRC64 ----------------
+static detail::crc64_kernel select_crc64_xz_kernel()
 {
-  auto file = open_file(filepath);
-  if (!file) return 0;
+#if UTILS_X86_SIMD
+  const cpu::feature_set &f = cpu::features();
+  if (f.pclmul && f.ssse3) return detail::crc64_xz_pclmul;
+#endif  // UTILS_X86_SIMD
+  return nullptr;
+}
 
-  uint16_t sum = 0;
-  auto buffer = make_buffer();
-  while (file.good())
+// CRC-64/XZ: 多项式 0x42F0E1EBA9EA3693, 反射
+static uint64_t crc64_update(uint64_t crc, const unsigned char *buf, size_t len)
+{
+  static const detail::crc64_kernel kernel = select_crc64_xz_kernel();
+
+  uint64_t reg = ~crc;
+  if (kernel != nullptr)
   {
-    file.read(buffer.data(), buffer.size());
-    for (std::streamsize i = 0; i < file.gcount(); ++i) sum += static_cast<uint8_t>(buffer[i]);
+    const size_t done = kernel(reg, buf, len);
+    buf += done;
+    len -= done;
   }
-  return static_cast<uint8_t>(sum & 0xFF);
+  return crc_catalog::crc64_xz::extend(~reg, buf, len);
 }
 
-uint16_t sum16(const std::string &data)
+void crc64_hasher::update(const void *data, size_t len)
+{
+  crc_ = crc64_update(crc_, bytes(data), len);
+}
+
+uint64_t crc64(const std::string &data)
+{
+  return hash_string<crc64_hasher>(data);
+}
+
+uint64_t crc64_file(const std::string &filepath, size_t buffer_size)
+{
+  return hash_file<crc64_hasher>(filepath, buffer_size);
+}
+
+static detail::crc64_kernel select_crc64_ecma_kernel()
 {
-  uint32_t sum = 0;
-  for (auto c : data) sum += static_cast<uint8_t>(c);
-  return static_cast<uint16_t>(sum & 0xFFFF);
+#if UTILS_X86_SIMD
+  const cpu::feature_set &f = cpu::features();
+  if (f.pclmul && f.ssse3) return detail::crc64_ecma_pclmul;
+#endif  // UTILS_X86_SIMD
+  return nullptr;
 }
 
-uint16_t sum16_file(const std::string &filepath)
+// CRC-64/ECMA-182: 多项式 0x42F0E1EBA9EA3693, 非反射; 寄存器即结果
+static uint64_t crc64_ecma_update(uint64_t crc, const unsigned char *buf, size_t len)
 {
-  auto file = open_file(filepath);
-  if (!file) return 0;
+  static const detail::crc64_kernel kernel = select_crc64_ecma_kernel();
 
-  uint32_t sum = 0;
-  auto buffer = make_buffer();
-  while (file.good())
+  if (kernel != nullptr)
   {
-    file.read(buffer.data(), buffer.size());
-    for (std::streamsize i = 0; i < file.gcount(); ++i) sum += static_cast<uint8_t>(buffer[i]);
+    const size_t done = kernel(crc, buf, len);
+    buf += done;
+    len -= done;
   }
-  return static_cast<uint16_t>(sum & 0xFFFF);
+  return crc_catalog::crc64_ecma_182::extend(crc, buf, len);
+}
+
+void crc64_ecma_hasher::update(const void *data, size_t len)
+{
+  crc_ = crc64_ecma_update(crc_, bytes(data), len);
+}
+
+uint64_t crc64_ecma(const std::string &data)
+{
+  return hash_string<crc64_ecma_hasher>(data);
+}
+
+uint64_t crc64_ecma_file(const std::string &filepath, size_t buffer_size)
+{
+  return hash_file<crc64_ecma_hasher>(filepath, buffer_size);
+}
+
+// ---------------- xxHash ----------------
+// 一次性计算与 hasher 实现在 xxhash.cpp
+uint64_t xxh64_file(const std::string &filepath, uint64_t seed, size_t buffer_size)
+{
+  return hash_file(filepath, buffer_size, xxh64_hasher(seed));
+}
+
+uint64_t xxh3_64_file(const std::string &filepath, uint64_t seed, size_t buffer_size)
+{
+  return hash_file(filepath, buffer_size, xxh3_64_hasher(seed));
+}
+
+hash128 xxh3_128_file(const std::string &filepath, uint64_t seed, size_t buffer_size)
+{
+  return hash_file(filepath, buffer_size, xxh3_128_hasher(seed));
+}
+
+// ---------------- 和校验 ----------------
+static detail::sum_kernel select_sum_kernel()
+{
+#if UTILS_X86_SIMD
+  const cpu::feature_set &f = cpu::features();
+  if (f.avx2) return detail::sum_avx2;
+  if (f.sse2) return detail::sum_sse2;
+#endif  // UTILS_X86_SIMD
+  return nullptr;
+}
+
+// 字节和; sum8/sum16/lrc8 只取低位, 按整数累加后截断与逐字节截断结果相同
+static uint64_t byte_sum(const unsigned char *buf, size_t len)
+{
+  static const detail::sum_kernel kernel = select_sum_kernel();
+
+  uint64_t sum = 0;
+  size_t i = kernel != nullptr ? kernel(sum, buf, len) : 0;
+  for (; i < len; ++i) sum += buf[i];
+  return sum;
+}
+
+void sum8_hasher::update(const void *data, size_t len)
+{
+  sum_ = static_cast<uint8_t>(sum_ + byte_sum(bytes(data), len));
+}
+
+uint8_t sum8(const std::string &data)
+{
+  return hash_string<sum8_hasher>(data);
+}
+
+uint8_t sum8_file(const std::string &filepath, size_t buffer_size)
+{
+  return hash_file<sum8_hasher>(filepath, buffer_size);
+}
+
+void sum16_hasher::update(const void *data, size_t len)
+{
+  sum_ = static_cast<uint16_t>(sum_ + byte_sum(bytes(data), len));
+}
+
+uint16_t sum16(const std::string &data)
+{
+  return hash_string<sum16_hasher>(data);
+}
+
+uint16_t sum16_file(const std::string &filepath, size_t buffer_size)
+{
+  return hash_file<sum16_hasher>(filepath, buffer_size);
 }
 
 // ---------------- 异或校验 ----------------
-uint8_t xor8(const std::string &data)
+static detail::xor_kernel select_xor_kernel()
 {
-  uint8_t val = 0;
-  for (auto c : data) val ^= static_cast<uint8_t>(c);
-  return val;
+#if UTILS_X86_SIMD
+  const cpu::feature_set &f = cpu::features();
+  if (f.avx2) return detail::xor_avx2;
+  if (f.sse2) return detail::xor_sse2;
+#endif  // UTILS_X86_SIMD
+  return nullptr;
 }
 
-uint8_t xor8_file(const std::string &filepath)
+void xor8_hasher::update(const void *data, size_t len)
 {
-  auto file = open_file(filepath);
-  if (!file) return 0;
+  static const detail::xor_kernel kernel = select_xor_kernel();
 
-  uint8_t val = 0;
-  auto buffer = make_buffer();
-  while (file.good())
-  {
-    file.read(buffer.data(), buffer.size());
-    for (std::streamsize i = 0; i < file.gcount(); ++i) val ^= static_cast<uint8_t>(buffer[i]);
-  }
-  return val;
+  const unsigned char *p = bytes(data);
+  uint8_t val = val_;
+  size_t i = kernel != nullptr ? kernel(val, p, len) : 0;
+  for (; i < len; ++i) val ^= p[i];
+  val_ = val;
+}
+
+uint8_t xor8(const std::string &data)
+{
+  return hash_string<xor8_hasher>(data);
+}
+
+uint8_t xor8_file(const std::string &filepath, size_t buffer_size)
+{
+  return hash_file<xor8_hasher>(filepath, buffer_size);
 }
 
 // ---------------- LRC ----------------
-uint8_t lrc8(const std::string &data)
+void lrc8_hasher::update(const void *data, size_t len)
 {
-  uint8_t sum = 0;
-  for (auto c : data) sum += static_cast<uint8_t>(c);
-  return static_cast<uint8_t>(-sum);
+  sum_ = static_cast<uint8_t>(sum_ + byte_sum(bytes(data), len));
 }
 
-uint8_t lrc8_file(const std::string &filepath)
+uint8_t lrc8(const std::string &data)
 {
-  auto file = open_file(filepath);
-  if (!file) return 0;
+  return hash_string<lrc8_hasher>(data);
+}
 
-  uint8_t sum = 0;
-  auto buffer = make_buffer();
-  while (file.good())
-  {
-    file.read(buffer.data(), buffer.size());
-    for (std::streamsize i = 0; i < file.gcount(); ++i) sum += static_cast<uint8_t>(buffer[i]);
-  }
-  return static_cast<uint8_t>(-sum);
+uint8_t lrc8_file(const std::string &filepath, size_t buffer_size)
+{
+  return hash_file<lrc8_hasher>(filepath, buffer_size);
 }
 
-// ---------------- Fletcher16 ----------------
-uint16_t fletcher16(const std::string &data)
+// ---------------- Fletcher / Adler ----------------
+// 两个和从小于模数的值开始时, 5552 字节 (与 zlib 的 NMAX 相同) 以内 sum2 不超出 32 bit, 每块只取一次模;
+// 各步的和与逐字节取模同余, 块末取模后结果不变
+static const size_t fletcher_block = 5552;
+
+static detail::fletcher_kernel select_fletcher_kernel()
 {
-  uint16_t sum1 = 0;
-  uint16_t sum2 = 0;
-  for (auto c : data)
-  {
-    sum1 = (sum1 + static_cast<uint8_t>(c)) % 255;
-    sum2 = (sum2 + sum1) % 255;
-  }
-  return (sum2 << 8) | sum1;
+#if UTILS_X86_SIMD
+  if (cpu::features().avx2) return detail::fletcher_avx2;
+#endif  // UTILS_X86_SIMD
+  return nullptr;
 }
 
-uint16_t fletcher16_file(const std::string &filepath)
+template <uint32_t Mod>
+static void fletcher_update(uint32_t &sum1, uint32_t &sum2, const unsigned char *buf, size_t len)
 {
-  auto file = open_file(filepath);
-  if (!file) return 0;
+  static const detail::fletcher_kernel kernel = select_fletcher_kernel();
 
-  uint16_t sum1 = 0;
-  uint16_t sum2 = 0;
-  auto buffer = make_buffer();
-  while (file.good())
+  while (len > 0)
   {
-    file.read(buffer.data(), buffer.size());
-    for (std::streamsize i = 0; i < file.gcount(); ++i)
+    const size_t n = std::min(len, fletcher_block);
+    uint32_t a = sum1;
+    uint32_t b = sum2;
+    size_t i = kernel != nullptr ? kernel(a, b, buf, n) : 0;
+    for (; i < n; ++i)
     {
-      sum1 = (sum1 + static_cast<uint8_t>(buffer[i])) % 255;
-      sum2 = (sum2 + sum1) % 255;
+      a += buf[i];
+      b += a;
     }
+    sum1 = a % Mod;
+    sum2 = b % Mod;
+    buf += n;
+    len -= n;
   }
-  return (sum2 << 8) | sum1;
+}
+
+// ---------------- Fletcher16 ----------------
+void fletcher16_hasher::update(const void *data, size_t len)
+{
+  uint32_t sum1 = sum1_;
+  uint32_t sum2 = sum2_;
+  fletcher_update<255>(sum1, sum2, bytes(data), len);
+  sum1_ = static_cast<uint16_t>(sum1);
+  sum2_ = static_cast<uint16_t>(sum2);
+}
+
+uint16_t fletcher16(const std::string &data)
+{
+  return hash_string<fletcher16_hasher>(data);
+}
+
+uint16_t fletcher16_file(const std::string &filepath, size_t buffer_size)
+{
+  return hash_file<fletcher16_hasher>(filepath, buffer_size);
 }
 
 // ---------------- Fletcher32 ----------------
+void fletcher32_hasher::update(const void *data, size_t len)
+{
+  fletcher_update<65535>(sum1_, sum2_, bytes(data), len);
+}
+
 uint32_t fletcher32(const std::string &data)
 {
-  uint32_t sum1 = 0;
-  uint32_t sum2 = 0;
-  for (auto c : data)
-  {
-    sum1 = (sum1 + static_cast<uint8_t>(c)) % 65535;
-    sum2 = (sum2 + sum1) % 65535;
-  }
-  return (sum2 << 16) | sum1;
+  return hash_string<fletcher32_hasher>(data);
 }
 
-uint32_t fletcher32_file(const std::string &filepath)
+uint32_t fletcher32_file(const std::string &filepath, size_t buffer_size)
 {
-  auto file = open_file(filepath);
-  if (!file) return 0;
+  return hash_file<fletcher32_hasher>(filepath, buffer_size);
+}
+
+// ---------------- Adler-32 ----------------
+void adler32_hasher::update(const void *data, size_t len)
+{
+  fletcher_update<65521>(a_, b_, bytes(data), len);
+}
 
-  uint32_t sum1 = 0;
-  uint32_t sum2 = 0;
-  auto buffer = make_buffer();
-  while (file.good())
+uint32_t adler32(const std::string &data)
+{
+  return hash_string<adler32_hasher>(data);
+}
+
+uint32_t adler32_file(const std::string &filepath, size_t buffer_size)
+{
+  return hash_file<adler32_hasher>(filepath, buffer_size);
+}
+
+// ---------------- 多种校验 ----------------
+multi_hasher::multi_hasher(checksum which) :
+  which_(static_cast<unsigned int>(which))
+{
+}
+
+void multi_hasher::update(const void *data, size_t len)
+{
+  // 每块不超过 L2 缓存, 第一个校验把数据读入缓存后, 其余校验从缓存读取
+  static const size_t slice = 64 * 1024;
+
+  const unsigned char *p = bytes(data);
+  for (size_t pos = 0; pos < len; pos += slice)
   {
-    file.read(buffer.data(), buffer.size());
-    for (std::streamsize i = 0; i < file.gcount(); ++i)
-    {
-      sum1 = (sum1 + static_cast<uint8_t>(buffer[i])) % 65535;
-      sum2 = (sum2 + sum1) % 65535;
-    }
+    const unsigned char *piece = p + pos;
+    const size_t n = std::min(slice, len - pos);
+    if (selected(checksum::crc8)) crc8_.update(piece, n);
+    if (selected(checksum::crc16)) crc16_.update(piece, n);
+    if (selected(checksum::crc32)) crc32_.update(piece, n);
+    if (selected(checksum::crc32c)) crc32c_.update(piece, n);
+    if (selected(checksum::sum8)) sum8_.update(piece, n);
+    if (selected(checksum::sum16)) sum16_.update(piece, n);
+    if (selected(checksum::xor8)) xor8_.update(piece, n);
+    if (selected(checksum::lrc8)) lrc8_.update(piece, n);
+    if (selected(checksum::fletcher16)) fletcher16_.update(piece, n);
+    if (selected(checksum::fletcher32)) fletcher32_.update(piece, n);
+    if (selected(checksum::crc64)) crc64_.update(piece, n);
+    if (selected(checksum::crc64_ecma)) crc64_ecma_.update(piece, n);
+    if (selected(checksum::adler32)) adler32_.update(piece, n);
+    if (selected(checksum::xxh64)) xxh64_.update(piece, n);
+    if (selected(checksum::xxh3_64)) xxh3_64_.update(piece, n);
+    if (selected(checksum::xxh3_128)) xxh3_128_.update(piece, n);
   }
-  return (sum2 << 16) | sum1;
+}
+
+checksums multi_hasher::value() const noexcept
+{
+  checksums result;
+  if (selected(checksum::crc8)) result.crc8 = crc8_.value();
+  if (selected(checksum::crc16)) result.crc16 = crc16_.value();
+  if (selected(checksum::crc32)) result.crc32 = crc32_.value();
+  if (selected(checksum::crc32c)) result.crc32c = crc32c_.value();
+  if (selected(checksum::sum8)) result.sum8 = sum8_.value();
+  if (selected(checksum::sum16)) result.sum16 = sum16_.value();
+  if (selected(checksum::xor8)) result.xor8 = xor8_.value();
+  if (selected(checksum::lrc8)) result.lrc8 = lrc8_.value();
+  if (selected(checksum::fletcher16)) result.fletcher16 = fletcher16_.value();
+  if (selected(checksum::fletcher32)) result.fletcher32 = fletcher32_.value();
+  if (selected(checksum::crc64)) result.crc64 = crc64_.value();
+  if (selected(checksum::crc64_ecma)) result.crc64_ecma = crc64_ecma_.value();
+  if (selected(checksum::adler32)) result.adler32 = adler32_.value();
+  if (selected(checksum::xxh64)) result.xxh64 = xxh64_.value();
+  if (selected(checksum::xxh3_64)) result.xxh3_64 = xxh3_64_.value();
+  if (selected(checksum::xxh3_128)) result.xxh3_128 = xxh3_128_.value();
+  return result;
+}
+
+void multi_hasher::reset() noexcept
+{
+  crc8_.reset();
+  crc16_.reset();
+  crc32_.reset();
+  crc32c_.reset();
+  sum8_.reset();
+  sum16_.reset();
+  xor8_.reset();
+  lrc8_.reset();
+  fletcher16_.reset();
+  fletcher32_.reset();
+  crc64_.reset();
+  crc64_ecma_.reset();
+  adler32_.reset();
+  xxh64_.reset();
+  xxh3_64_.reset();
+  xxh3_128_.reset();
+}
+
+checksums multi_checksum(const std::string &data, checksum which)
+{
+  multi_hasher hasher(which);
+  hasher.update(data);
+  return hasher.value();
+}
+
+bool multi_checksum_file(const std::string &filepath, checksum which, checksums &result, size_t buffer_size)
+{
+  fileio::file_reader file(filepath, buffer_size);
+  if (!file.is_open()) return false;
+
+  multi_hasher hasher(which);
+  const unsigned char *data = nullptr;
+  size_t len = 0;
+  while (file.next(data, len)) hasher.update(data, len);
+  if (file.failed()) return false;
+
+  result = hasher.value();
+  return true;
 }
 
 }  // namespace checkutils
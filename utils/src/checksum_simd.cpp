@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file checksum_simd.cpp
+ * @brief 和 / 异或 / Fletcher / Adler 类校验的 SSE2 与 AVX2 内核
+ *
+ * 字节和用 psadbw 每 8 字节求一次和, 累加在 64 bit lane 中; 异或先在向量中归并, 最后折叠到 1 字节.
+ *
+ * Fletcher / Adler 32 字节一块: sum1 增加块内字节和, sum2 增加 32 * (块开始时的 sum1) 与按 32, 31, ..., 1
+ * 加权的字节和. 各 lane 分别累加, 最后水平求和.
+ *
+ * @author abin
+ * @date 2025-12-17
+ */
+
+#include "checksum_simd.h"
+
+#if UTILS_X86_SIMD
+
+namespace checkutils
+{
+namespace detail
+{
+namespace
+{
+UTILS_TARGET("sse2") inline uint64_t sum_lanes(__m128i v)
+{
+  v = _mm_add_epi64(v, _mm_unpackhi_epi64(v, v));
+  uint64_t sum;
+  _mm_storel_epi64(reinterpret_cast<__m128i *>(&sum), v);
+  return sum;
+}
+
+UTILS_TARGET("sse2") inline uint8_t xor_lanes(__m128i v)
+{
+  v = _mm_xor_si128(v, _mm_unpackhi_epi64(v, v));
+  uint64_t x;
+  _mm_storel_epi64(reinterpret_cast<__m128i *>(&x), v);
+  x ^= x >> 32;
+  x ^= x >> 16;
+  x ^= x >> 8;
+  return static_cast<uint8_t>(x);
+}
+
+UTILS_TARGET("sse2") inline __m128i load_128(const unsigned char *p)
+{
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+UTILS_TARGET("avx2") inline __m256i load_256(const unsigned char *p)
+{
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+UTILS_TARGET("avx2") inline uint32_t horizontal_sum(__m256i v)
+{
+  __m128i x = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+  x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+  x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+  return static_cast<uint32_t>(_mm_cvtsi128_si32(x));
+}
+}  // namespace
+
+// ---------------- 字节和 ----------------
+// 四个累加器交替使用, 隐藏加法的延迟
+UTILS_TARGET("sse2") size_t sum_sse2(uint64_t &sum, const unsigned char *buf, size_t len)
+{
+  const size_t total = len & ~static_cast<size_t>(63);
+  const __m128i zero = _mm_setzero_si128();
+  __m128i s0 = zero;
+  __m128i s1 = zero;
+  __m128i s2 = zero;
+  __m128i s3 = zero;
+  for (size_t i = 0; i < total; i += 64)
+  {
+    s0 = _mm_add_epi64(s0, _mm_sad_epu8(load_128(buf + i), zero));
+    s1 = _mm_add_epi64(s1, _mm_sad_epu8(load_128(buf + i + 16), zero));
+    s2 = _mm_add_epi64(s2, _mm_sad_epu8(load_128(buf + i + 32), zero));
+    s3 = _mm_add_epi64(s3, _mm_sad_epu8(load_128(buf + i + 48), zero));
+  }
+  sum += sum_lanes(_mm_add_epi64(_mm_add_epi64(s0, s1), _mm_add_epi64(s2, s3)));
+  return total;
+}
+
+UTILS_TARGET("avx2") size_t sum_avx2(uint64_t &sum, const unsigned char *buf, size_t len)
+{
+  const size_t total = len & ~static_cast<size_t>(127);
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i s0 = zero;
+  __m256i s1 = zero;
+  __m256i s2 = zero;
+  __m256i s3 = zero;
+  for (size_t i = 0; i < total; i += 128)
+  {
+    s0 = _mm256_add_epi64(s0, _mm256_sad_epu8(load_256(buf + i), zero));
+    s1 = _mm256_add_epi64(s1, _mm256_sad_epu8(load_256(buf + i + 32), zero));
+    s2 = _mm256_add_epi64(s2, _mm256_sad_epu8(load_256(buf + i + 64), zero));
+    s3 = _mm256_add_epi64(s3, _mm256_sad_epu8(load_256(buf + i + 96), zero));
+  }
+  const __m256i s = _mm256_add_epi64(_mm256_add_epi64(s0, s1), _mm256_add_epi64(s2, s3));
+  sum += sum_lanes(_mm_add_epi64(_mm256_castsi256_si128(s), _mm256_extracti128_si256(s, 1)));
+  _mm256_zeroupper();
+  return total;
+}
+
+// ---------------- 字节异或 ----------------
+UTILS_TARGET("sse2") size_t xor_sse2(uint8_t &val, const unsigned char *buf, size_t len)
+{
+  const size_t total = len & ~static_cast<size_t>(63);
+  __m128i x0 = _mm_cvtsi32_si128(val);
+  __m128i x1 = _mm_setzero_si128();
+  __m128i x2 = _mm_setzero_si128();
+  __m128i x3 = _mm_setzero_si128();
+  for (size_t i = 0; i < total; i += 64)
+  {
+    x0 = _mm_xor_si128(x0, load_128(buf + i));
+    x1 = _mm_xor_si128(x1, load_128(buf + i + 16));
+    x2 = _mm_xor_si128(x2, load_128(buf + i + 32));
+    x3 = _mm_xor_si128(x3, load_128(buf + i + 48));
+  }
+  val = xor_lanes(_mm_xor_si128(_mm_xor_si128(x0, x1), _mm_xor_si128(x2, x3)));
+  return total;
+}
+
+UTILS_TARGET("avx2") size_t xor_avx2(uint8_t &val, const unsigned char *buf, size_t len)
+{
+  const size_t total = len & ~static_cast<size_t>(127);
+  __m256i x0 = _mm256_castsi128_si256(_mm_cvtsi32_si128(val));
+  x0 = _mm256_inserti128_si256(x0, _mm_setzero_si128(), 1);
+  __m256i x1 = _mm256_setzero_si256();
+  __m256i x2 = _mm256_setzero_si256();
+  __m256i x3 = _mm256_setzero_si256();
+  for (size_t i = 0; i < total; i += 128)
+  {
+    x0 = _mm256_xor_si256(x0, load_256(buf + i));
+    x1 = _mm256_xor_si256(x1, load_256(buf + i + 32));
+    x2 = _mm256_xor_si256(x2, load_256(buf + i + 64));
+    x3 = _mm256_xor_si256(x3, load_256(buf + i + 96));
+  }
+  const __m256i x = _mm256_xor_si256(_mm256_xor_si256(x0, x1), _mm256_xor_si256(x2, x3));
+  val = xor_lanes(_mm_xor_si128(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1)));
+  _mm256_zeroupper();
+  return total;
+}
+
+// ---------------- Fletcher / Adler ----------------
+UTILS_TARGET("avx2") size_t fletcher_avx2(uint32_t &sum1, uint32_t &sum2, const unsigned char *buf, size_t len)
+{
+  const size_t total = len & ~static_cast<size_t>(31);
+  if (total == 0) return 0;
+
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i ones = _mm256_set1_epi16(1);
+  const __m256i weights = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15,
+                                           14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+  __m256i bytes = zero;     // 已处理的字节和
+  __m256i prefixes = zero;  // 每块开始时 bytes 的累计
+  __m256i weighted = zero;  // 块内加权和
+  for (size_t i = 0; i < total; i += 32)
+  {
+    const __m256i v = load_256(buf + i);
+    prefixes = _mm256_add_epi32(prefixes, bytes);
+    // sad 的结果在每个 64 bit lane 的低 32 bit, 高 32 bit 为 0, 按 32 bit 累加不会进位
+    bytes = _mm256_add_epi32(bytes, _mm256_sad_epu8(v, zero));
+    // 255 * (32 + 31) 不超出 int16, maddubs 不会饱和
+    weighted = _mm256_add_epi32(weighted, _mm256_madd_epi16(_mm256_maddubs_epi16(v, weights), ones));
+  }
+
+  sum2 += static_cast<uint32_t>(total) * sum1 + 32 * horizontal_sum(prefixes) + horizontal_sum(weighted);
+  sum1 += horizontal_sum(bytes);
+  _mm256_zeroupper();
+  return total;
+}
+
+}  // namespace detail
+}  // namespace checkutils
+
+#endif  // UTILS_X86_SIMD
@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file checksum_simd.h
+ * @brief 和 / 异或 / Fletcher / Adler 类校验的 SIMD 内核（库内部使用，由 check.cpp 在运行时按 CPU 特性分派）
+ *
+ * 内核只做不取模的累加, 返回已消耗的输入字节数; 截断或取模与剩余的尾部由 check.cpp 完成.
+ *
+ * @author abin
+ * @date 2025-12-17
+ */
+
+#ifndef __GUARD_CHECKSUM_SIMD_H_INCLUDE_GUARD__
+#define __GUARD_CHECKSUM_SIMD_H_INCLUDE_GUARD__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cpu_features.h"
+
+namespace checkutils
+{
+namespace detail
+{
+
+// 字节和 (sum8/sum16/lrc8 分别取低 8/16 bit) 与字节异或
+using sum_kernel = size_t (*)(uint64_t &sum, const unsigned char *buf, size_t len);
+using xor_kernel = size_t (*)(uint8_t &val, const unsigned char *buf, size_t len);
+
+// 逐字节 sum1 += byte, sum2 += sum1 的累加 (Fletcher16/32 与 Adler-32 共用);
+// 调用方保证 len 足够小, 使结果不超出 32 bit
+using fletcher_kernel = size_t (*)(uint32_t &sum1, uint32_t &sum2, const unsigned char *buf, size_t len);
+
+#if UTILS_X86_SIMD
+// psadbw 求字节和, 宽向量异或; 分别处理 64 / 128 字节整数倍的前缀
+size_t sum_sse2(uint64_t &sum, const unsigned char *buf, size_t len);
+size_t sum_avx2(uint64_t &sum, const unsigned char *buf, size_t len);
+size_t xor_sse2(uint8_t &val, const unsigned char *buf, size_t len);
+size_t xor_avx2(uint8_t &val, const unsigned char *buf, size_t len);
+
+// 处理 32 字节整数倍的前缀
+size_t fletcher_avx2(uint32_t &sum1, uint32_t &sum2, const unsigned char *buf, size_t len);
+#endif  // UTILS_X86_SIMD
+
+}  // namespace detail
+}  // namespace checkutils
+
+#endif  // __GUARD_CHECKSUM_SIMD_H_INCLUDE_GUARD__
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file cpu_features.h
+ * @brief 运行时 CPU 指令集检测（库内部使用，不对外安装）
+ *
+ * 提供：
+ *  - UTILS_X86_SIMD: 当前平台是否编译 x86 SIMD 内核（定义 UTILS_NO_SIMD 可整体关闭）
+ *  - UTILS_TARGET(x): 为单个函数开启指定指令集（GCC/Clang 使用 target 属性, MSVC 无需开启）
+ *  - cpu::features(): 进程内只检测一次的 CPU 特性表（含 OS 对 YMM/ZMM 状态的支持检查）
+ *
+ * @author abin
+ * @date 2025-12-06
+ */
+
+#ifndef __GUARD_CPU_FEATURES_H_INCLUDE_GUARD__
+#define __GUARD_CPU_FEATURES_H_INCLUDE_GUARD__
+
+#include <cstdint>
+
+#if !defined(UTILS_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define UTILS_X86_SIMD 1
+#else
+#define UTILS_X86_SIMD 0
+#endif
+
+#if UTILS_X86_SIMD
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define UTILS_TARGET(x)
+#else
+#include <cpuid.h>
+#define UTILS_TARGET(x) __attribute__((target(x)))
+#endif
+#include <immintrin.h>
+#endif  // UTILS_X86_SIMD
+
+namespace cpu
+{
+
+struct feature_set
+{
+  bool sse2 = false;
+  bool ssse3 = false;
+  bool sse41 = false;
+  bool sse42 = false;
+  bool pclmul = false;
+  bool avx2 = false;
+  bool bmi2 = false;
+  bool avx512bw = false;    // AVX-512 F + BW (含 OS 对 ZMM 状态的支持)
+  bool avx512vbmi = false;  // AVX-512 VBMI (隐含 avx512bw)
+  bool sha = false;         // SHA-NI
+};
+
+namespace detail
+{
+#if UTILS_X86_SIMD
+inline void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4])
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  int r[4];
+  __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+  for (int i = 0; i < 4; ++i) regs[i] = static_cast<uint32_t>(r[i]);
+#else
+  __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+inline uint64_t xgetbv0()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  return _xgetbv(0);
+#else
+  uint32_t eax = 0;
+  uint32_t edx = 0;
+  __asm__ volatile(".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c"(0));  // xgetbv
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+#endif  // UTILS_X86_SIMD
+
+inline feature_set detect()
+{
+  feature_set f;
+#if UTILS_X86_SIMD
+  uint32_t r[4] = {0, 0, 0, 0};
+  cpuid(0, 0, r);
+  const uint32_t max_leaf = r[0];
+  if (max_leaf < 1) return f;
+
+  cpuid(1, 0, r);
+  const uint32_t ecx1 = r[2];
+  const uint32_t edx1 = r[3];
+  f.sse2 = (edx1 & (1U << 26)) != 0;
+  f.ssse3 = (ecx1 & (1U << 9)) != 0;
+  f.sse41 = (ecx1 & (1U << 19)) != 0;
+  f.sse42 = (ecx1 & (1U << 20)) != 0;
+  f.pclmul = (ecx1 & (1U << 1)) != 0;
+
+  // AVX/AVX-512 需要 OS 通过 XSAVE 保存对应寄存器状态
+  const bool osxsave = (ecx1 & (1U << 27)) != 0;
+  const uint64_t xcr0 = osxsave ? xgetbv0() : 0;
+  const bool os_ymm = (xcr0 & 0x06) == 0x06;
+  const bool os_zmm = (xcr0 & 0xE6) == 0xE6;
+
+  if (max_leaf >= 7)
+  {
+    cpuid(7, 0, r);
+    const uint32_t ebx7 = r[1];
+    const uint32_t ecx7 = r[2];
+    f.avx2 = os_ymm && (ebx7 & (1U << 5)) != 0;
+    f.bmi2 = (ebx7 & (1U << 8)) != 0;
+    f.sha = (ebx7 & (1U << 29)) != 0;
+    f.avx512bw = os_zmm && (ebx7 & (1U << 16)) != 0 && (ebx7 & (1U << 30)) != 0;
+    f.avx512vbmi = f.avx512bw && (ecx7 & (1U << 1)) != 0;
+  }
+#endif  // UTILS_X86_SIMD
+  return f;
+}
+}  // namespace detail
+
+// 进程内只检测一次, 线程安全 (C++11 局部静态变量)
+inline const feature_set &features()
+{
+  static const feature_set f = detail::detect();
+  return f;
+}
+
+}  // namespace cpu
+
+#endif  // __GUARD_CPU_FEATURES_H_INCLUDE_GUARD__
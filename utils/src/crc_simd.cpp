@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file crc_simd.cpp
+ * @brief CRC32 / CRC64 的 PCLMULQDQ 折叠内核与 CRC32C 的 SSE4.2 内核
+ *
+ * 折叠算法参考 Intel 白皮书:
+ *   "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction"
+ * 常量为反射域中的 x^n mod P (n 见注释), 以及 Barrett 约简用的 P' 与 u'.
+ * CRC64 折叠到最后 128 bit 后交给 utils/crc.h 的查表代码约简, 只多算 16 字节.
+ *
+ * @author abin
+ * @date 2025-12-13
+ */
+
+#include "crc_simd.h"
+
+#include <cstring>
+
+#include "utils/crc.h"
+
+#if UTILS_X86_SIMD
+
+namespace checkutils
+{
+namespace detail
+{
+namespace
+{
+// x 的低、高 64 bit 分别乘以 k 的低、高 64 bit, 与 data 异或: 把 128 bit 向后折叠
+UTILS_TARGET("pclmul") inline __m128i fold_128(__m128i x, __m128i k, __m128i data)
+{
+  const __m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+  const __m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+  return _mm_xor_si128(_mm_xor_si128(hi, lo), data);
+}
+
+UTILS_TARGET("pclmul") inline __m128i load_128(const unsigned char *p)
+{
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+// 高、低 64 bit 组成的 128 bit 常量
+UTILS_TARGET("pclmul") inline __m128i make_128(uint64_t hi, uint64_t lo)
+{
+  return _mm_set_epi64x(static_cast<long long>(hi), static_cast<long long>(lo));
+}
+
+// 非反射 CRC 按大端顺序处理, 载入时把 16 字节整体反转
+UTILS_TARGET("pclmul,ssse3") inline __m128i byte_reverse(__m128i v)
+{
+  return _mm_shuffle_epi8(v, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+template <bool Reflected>
+UTILS_TARGET("pclmul,ssse3") inline __m128i load_crc64(const unsigned char *p)
+{
+  return Reflected ? load_128(p) : byte_reverse(load_128(p));
+}
+
+// 把 [p, end) 的 16 字节块 (长度为 16 的整数倍且不少于 64) 折叠为 128 bit, first 与第一块异或;
+// k4 每次前进 4 * 128 bit, k1 每次前进 128 bit
+template <bool Reflected>
+UTILS_TARGET("pclmul,ssse3")
+__m128i crc64_fold(__m128i first, const unsigned char *p, const unsigned char *end, __m128i k4, __m128i k1)
+{
+  __m128i x0 = _mm_xor_si128(load_crc64<Reflected>(p), first);
+  __m128i x1 = load_crc64<Reflected>(p + 16);
+  __m128i x2 = load_crc64<Reflected>(p + 32);
+  __m128i x3 = load_crc64<Reflected>(p + 48);
+  for (p += 64; end - p >= 64; p += 64)
+  {
+    x0 = fold_128(x0, k4, load_crc64<Reflected>(p));
+    x1 = fold_128(x1, k4, load_crc64<Reflected>(p + 16));
+    x2 = fold_128(x2, k4, load_crc64<Reflected>(p + 32));
+    x3 = fold_128(x3, k4, load_crc64<Reflected>(p + 48));
+  }
+
+  x0 = fold_128(x0, k1, x1);
+  x0 = fold_128(x0, k1, x2);
+  x0 = fold_128(x0, k1, x3);
+  for (; p != end; p += 16) x0 = fold_128(x0, k1, load_crc64<Reflected>(p));
+  return x0;
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+inline uint64_t load_64(const unsigned char *p)
+{
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+// 三段各 Block 字节交错计算再合并; k_single, k_double 为 x^(8 * Block - 33), x^(16 * Block - 33) mod P
+template <size_t Block>
+UTILS_TARGET("sse4.2,pclmul")
+size_t crc32c_3way(uint32_t &crc, const unsigned char *buf, size_t len, uint32_t k_single, uint32_t k_double)
+{
+  size_t pos = 0;
+  for (; len - pos >= 3 * Block; pos += 3 * Block)
+  {
+    const unsigned char *p = buf + pos;
+    uint64_t a = crc;
+    uint64_t b = 0;
+    uint64_t c = 0;
+    for (size_t i = 0; i < Block; i += 8)
+    {
+      a = _mm_crc32_u64(a, load_64(p + i));
+      b = _mm_crc32_u64(b, load_64(p + Block + i));
+      c = _mm_crc32_u64(c, load_64(p + 2 * Block + i));
+    }
+    // a * x^(16 * Block) + b * x^(8 * Block) + c; 反射域的乘积少乘一个 x, 常量中已扣除,
+    // 最后由 crc32 指令乘以 x^32 并约简
+    const __m128i ta = _mm_clmulepi64_si128(_mm_cvtsi32_si128(static_cast<int>(a)),
+                                            _mm_cvtsi32_si128(static_cast<int>(k_double)), 0x00);
+    const __m128i tb = _mm_clmulepi64_si128(_mm_cvtsi32_si128(static_cast<int>(b)),
+                                            _mm_cvtsi32_si128(static_cast<int>(k_single)), 0x00);
+    const uint64_t t = static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_xor_si128(ta, tb)));
+    crc = static_cast<uint32_t>(_mm_crc32_u64(0, t) ^ c);
+  }
+  return pos;
+}
+#endif  // x86-64
+}  // namespace
+
+// ---------------- CRC32 (PCLMULQDQ) ----------------
+UTILS_TARGET("pclmul,sse4.1") size_t crc32_pclmul(uint32_t &crc, const unsigned char *buf, size_t len)
+{
+  if (len < 64) return 0;
+  const size_t total = len & ~static_cast<size_t>(15);
+  const unsigned char *p = buf;
+  const unsigned char *end = buf + total;
+
+  // 4 路并行折叠, 每次前进 64 字节: x^(4 * 128 + 32), x^(4 * 128 - 32)
+  const __m128i k1k2 = _mm_set_epi64x(0x1c6e41596, 0x154442bd4);
+  __m128i x0 = _mm_xor_si128(load_128(p), _mm_cvtsi32_si128(static_cast<int>(crc)));
+  __m128i x1 = load_128(p + 16);
+  __m128i x2 = load_128(p + 32);
+  __m128i x3 = load_128(p + 48);
+  for (p += 64; end - p >= 64; p += 64)
+  {
+    x0 = fold_128(x0, k1k2, load_128(p));
+    x1 = fold_128(x1, k1k2, load_128(p + 16));
+    x2 = fold_128(x2, k1k2, load_128(p + 32));
+    x3 = fold_128(x3, k1k2, load_128(p + 48));
+  }
+
+  // 合并为 128 bit, 再逐个折入剩余的 16 字节块: x^(128 + 32), x^(128 - 32)
+  const __m128i k3k4 = _mm_set_epi64x(0x0ccaa009e, 0x1751997d0);
+  x0 = fold_128(x0, k3k4, x1);
+  x0 = fold_128(x0, k3k4, x2);
+  x0 = fold_128(x0, k3k4, x3);
+  for (; p != end; p += 16) x0 = fold_128(x0, k3k4, load_128(p));
+
+  // 128 bit -> 64 bit: x^64
+  const __m128i mask32 = _mm_setr_epi32(-1, 0, -1, 0);
+  x0 = _mm_xor_si128(_mm_srli_si128(x0, 8), _mm_clmulepi64_si128(x0, k3k4, 0x10));
+  const __m128i k5 = _mm_set_epi64x(0, 0x163cd6124);
+  x0 = _mm_xor_si128(_mm_srli_si128(x0, 4), _mm_clmulepi64_si128(_mm_and_si128(x0, mask32), k5, 0x00));
+
+  // Barrett 约简到 32 bit
+  const __m128i poly = _mm_set_epi64x(0x1f7011641, 0x1db710641);
+  __m128i t = _mm_clmulepi64_si128(_mm_and_si128(x0, mask32), poly, 0x10);
+  t = _mm_clmulepi64_si128(_mm_and_si128(t, mask32), poly, 0x00);
+  crc = static_cast<uint32_t>(_mm_extract_epi32(_mm_xor_si128(x0, t), 1));
+  return total;
+}
+
+// ---------------- CRC32C (SSE4.2) ----------------
+UTILS_TARGET("sse4.2") size_t crc32c_sse42(uint32_t &crc, const unsigned char *buf, size_t len)
+{
+  size_t pos = 0;
+#if defined(__x86_64__) || defined(_M_X64)
+  uint64_t c = crc;
+  for (; len - pos >= 8; pos += 8) c = _mm_crc32_u64(c, load_64(buf + pos));
+  uint32_t c32 = static_cast<uint32_t>(c);
+#else
+  uint32_t c32 = crc;
+  for (; len - pos >= 4; pos += 4)
+  {
+    uint32_t v;
+    std::memcpy(&v, buf + pos, sizeof(v));
+    c32 = _mm_crc32_u32(c32, v);
+  }
+#endif
+  for (; pos < len; ++pos) c32 = _mm_crc32_u8(c32, buf[pos]);
+  crc = c32;
+  return len;
+}
+
+UTILS_TARGET("sse4.2,pclmul") size_t crc32c_sse42_pclmul(uint32_t &crc, const unsigned char *buf, size_t len)
+{
+  size_t pos = 0;
+#if defined(__x86_64__) || defined(_M_X64)
+  // 长输入用 2 KiB 的段, 中等长度用 256 字节的段
+  pos += crc32c_3way<2048>(crc, buf, len, 0xa51b6135, 0x82f89c77);
+  pos += crc32c_3way<256>(crc, buf + pos, len - pos, 0xb9e02b86, 0xdd7e3b0c);
+#endif  // x86-64
+  return pos + crc32c_sse42(crc, buf + pos, len - pos);
+}
+
+// ---------------- CRC64 (PCLMULQDQ) ----------------
+// 多项式 0x42F0E1EBA9EA3693; 剩余的 128 bit 当作 16 字节数据从零寄存器开始查表, 即乘以 x^64 后模 P
+UTILS_TARGET("pclmul,ssse3") size_t crc64_xz_pclmul(uint64_t &crc, const unsigned char *buf, size_t len)
+{
+  if (len < 64) return 0;
+  const size_t total = len & ~static_cast<size_t>(15);
+
+  // 反射域中先到的数据在低 64 bit, 乘积少乘的一个 x 在常量中扣除:
+  // x^(4 * 128 + 64 - 1), x^(4 * 128 - 1); x^(128 + 64 - 1), x^(128 - 1)
+  const __m128i k4 = make_128(0x081f6054a7842df4, 0x6ae3efbb9dd441f3);
+  const __m128i k1 = make_128(0xdabe95afc7875f40, 0xe05dd497ca393ae4);
+  const __m128i x = crc64_fold<true>(make_128(0, crc), buf, buf + total, k4, k1);
+
+  alignas(16) unsigned char rest[16];
+  _mm_store_si128(reinterpret_cast<__m128i *>(rest), x);
+  crc = crc_detail::update<uint64_t, crc_detail::reflect(0x42F0E1EBA9EA3693, 64), true>(0, rest, sizeof(rest));
+  return total;
+}
+
+UTILS_TARGET("pclmul,ssse3") size_t crc64_ecma_pclmul(uint64_t &crc, const unsigned char *buf, size_t len)
+{
+  if (len < 64) return 0;
+  const size_t total = len & ~static_cast<size_t>(15);
+
+  // 大端载入后先到的数据在高 64 bit: x^(4 * 128 + 64), x^(4 * 128); x^(128 + 64), x^128
+  const __m128i k4 = make_128(0xddf4b6981205b83f, 0x5f6843ca540df020);
+  const __m128i k1 = make_128(0x4eb938a7d257740e, 0x05f5c3c7eb52fab6);
+  const __m128i x = crc64_fold<false>(make_128(crc, 0), buf, buf + total, k4, k1);
+
+  alignas(16) unsigned char rest[16];
+  _mm_store_si128(reinterpret_cast<__m128i *>(rest), byte_reverse(x));
+  crc = crc_detail::update<uint64_t, 0x42F0E1EBA9EA3693, false>(0, rest, sizeof(rest));
+  return total;
+}
+
+}  // namespace detail
+}  // namespace checkutils
+
+#endif  // UTILS_X86_SIMD
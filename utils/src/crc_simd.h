@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file crc_simd.h
+ * @brief CRC32 / CRC32C / CRC64 硬件加速内核（库内部使用，由 check.cpp 在运行时按 CPU 特性分派）
+ *
+ * 内核直接更新 CRC 寄存器 (即初始取反之后、最终取反之前的值), 返回已消耗的输入字节数,
+ * 剩余的尾部由 check.cpp 中的查表代码完成。
+ *
+ * @author abin
+ * @date 2025-12-13
+ */
+
+#ifndef __GUARD_CRC_SIMD_H_INCLUDE_GUARD__
+#define __GUARD_CRC_SIMD_H_INCLUDE_GUARD__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cpu_features.h"
+
+namespace checkutils
+{
+namespace detail
+{
+
+using crc32_kernel = size_t (*)(uint32_t &crc, const unsigned char *buf, size_t len);
+using crc64_kernel = size_t (*)(uint64_t &crc, const unsigned char *buf, size_t len);
+
+#if UTILS_X86_SIMD
+// CRC32 (IEEE 802.3): PCLMULQDQ 折叠, 只处理不少于 64 字节时的 16 字节整数倍前缀
+size_t crc32_pclmul(uint32_t &crc, const unsigned char *buf, size_t len);
+
+// CRC32C (Castagnoli): SSE4.2 crc32 指令, 处理全部输入;
+// _pclmul 版本对长输入交错计算三段再用 PCLMULQDQ 合并, 隐藏 crc32 指令的延迟
+size_t crc32c_sse42(uint32_t &crc, const unsigned char *buf, size_t len);
+size_t crc32c_sse42_pclmul(uint32_t &crc, const unsigned char *buf, size_t len);
+
+// CRC-64/XZ (反射) 与 CRC-64/ECMA-182 (非反射): PCLMULQDQ 折叠, 同样只处理不少于 64 字节时的 16 字节整数倍前缀
+size_t crc64_xz_pclmul(uint64_t &crc, const unsigned char *buf, size_t len);
+size_t crc64_ecma_pclmul(uint64_t &crc, const unsigned char *buf, size_t len);
+#endif  // UTILS_X86_SIMD
+
+}  // namespace detail
+}  // namespace checkutils
+
+#endif  // __GUARD_CRC_SIMD_H_INCLUDE_GUARD__
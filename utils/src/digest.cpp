@@ -0,0 +1,776 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file digest.cpp
+ * @brief SHA-256 (FIPS 180-4) / SHA-1 (FIPS 180-4) / MD5 (RFC 1321)
+ *
+ * 三种摘要结构相同: 64 字节一块更新 32 bit 字组成的链接值, 最后补 0x80、若干 0 与 64 bit 的消息长度.
+ * 区别只在压缩函数与字节序 (SHA 为大端, MD5 为小端), 由 *_algo 描述, 其余代码共用.
+ *
+ * 多条消息时每条消息占一个 lane: 每次取各 lane 剩余块数的最小值交给多消息内核, 消息结束的 lane
+ * 换入下一条消息; 同时进行的消息不足 3 条时, 余下部分逐条计算更快.
+ *
+ * @author abin
+ * @date 2025-12-17
+ */
+
+#include "utils/digest.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include "digest_simd.h"
+#include "file_io.h"
+#include "utils/make_unique.h"
+
+namespace checkutils
+{
+
+namespace detail
+{
+const uint32_t sha256_k[64] = {
+  0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+  0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+  0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+  0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+  0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+  0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+  0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+  0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+};
+
+// floor(abs(sin(i + 1)) * 2^32)
+const uint32_t md5_k[64] = {
+  0xD76AA478, 0xE8C7B756, 0x242070DB, 0xC1BDCEEE, 0xF57C0FAF, 0x4787C62A, 0xA8304613, 0xFD469501,
+  0x698098D8, 0x8B44F7AF, 0xFFFF5BB1, 0x895CD7BE, 0x6B901122, 0xFD987193, 0xA679438E, 0x49B40821,
+  0xF61E2562, 0xC040B340, 0x265E5A51, 0xE9B6C7AA, 0xD62F105D, 0x02441453, 0xD8A1E681, 0xE7D3FBC8,
+  0x21E1CDE6, 0xC33707D6, 0xF4D50D87, 0x455A14ED, 0xA9E3E905, 0xFCEFA3F8, 0x676F02D9, 0x8D2A4C8A,
+  0xFFFA3942, 0x8771F681, 0x6D9D6122, 0xFDE5380C, 0xA4BEEA44, 0x4BDECFA9, 0xF6BB4B60, 0xBEBFBC70,
+  0x289B7EC6, 0xEAA127FA, 0xD4EF3085, 0x04881D05, 0xD9D4D039, 0xE6DB99E5, 0x1FA27CF8, 0xC4AC5665,
+  0xF4292244, 0x432AFF97, 0xAB9423A7, 0xFC93A039, 0x655B59C3, 0x8F0CCC92, 0xFFEFF47D, 0x85845DD1,
+  0x6FA87E4F, 0xFE2CE6E0, 0xA3014314, 0x4E0811A1, 0xF7537E82, 0xBD3AF235, 0x2AD7D2BB, 0xEB86D391,
+};
+}  // namespace detail
+
+namespace
+{
+const size_t block_size = 64;
+
+inline uint32_t rotl32(uint32_t v, int r)
+{
+  return (v << r) | (v >> (32 - r));
+}
+
+inline uint32_t load_be32(const unsigned char *p)
+{
+  return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+         (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+inline uint32_t load_le32(const unsigned char *p)
+{
+  return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) |
+         (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// ---------------- 可移植的压缩函数 ----------------
+// 与 digest_simd.cpp 的多消息内核相同, 每次展开若干轮并轮换变量名, 代替每轮对所有变量的移动
+inline void sha256_round(uint32_t a, uint32_t b, uint32_t c, uint32_t &d, uint32_t e, uint32_t f, uint32_t g,
+                         uint32_t &h, uint32_t kw)
+{
+  const uint32_t s1 = rotl32(e, 26) ^ rotl32(e, 21) ^ rotl32(e, 7);
+  const uint32_t ch = g ^ (e & (f ^ g));
+  const uint32_t t1 = h + s1 + ch + kw;
+  const uint32_t s0 = rotl32(a, 30) ^ rotl32(a, 19) ^ rotl32(a, 10);
+  const uint32_t maj = (a & b) | (c & (a | b));
+  d += t1;
+  h = t1 + s0 + maj;
+}
+
+void sha256_portable(uint32_t *state, const unsigned char *blocks, size_t count)
+{
+  for (size_t n = 0; n < count; ++n)
+  {
+    const unsigned char *p = blocks + block_size * n;
+    uint32_t w[64];
+    for (size_t t = 0; t < 16; ++t) w[t] = load_be32(p + 4 * t);
+    for (size_t t = 16; t < 64; ++t)
+    {
+      const uint32_t s0 = rotl32(w[t - 15], 25) ^ rotl32(w[t - 15], 14) ^ (w[t - 15] >> 3);
+      const uint32_t s1 = rotl32(w[t - 2], 15) ^ rotl32(w[t - 2], 13) ^ (w[t - 2] >> 10);
+      w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+    }
+    for (size_t t = 0; t < 64; ++t) w[t] += detail::sha256_k[t];
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (size_t t = 0; t < 64; t += 8)
+    {
+      sha256_round(a, b, c, d, e, f, g, h, w[t]);
+      sha256_round(h, a, b, c, d, e, f, g, w[t + 1]);
+      sha256_round(g, h, a, b, c, d, e, f, w[t + 2]);
+      sha256_round(f, g, h, a, b, c, d, e, w[t + 3]);
+      sha256_round(e, f, g, h, a, b, c, d, w[t + 4]);
+      sha256_round(d, e, f, g, h, a, b, c, w[t + 5]);
+      sha256_round(c, d, e, f, g, h, a, b, w[t + 6]);
+      sha256_round(b, c, d, e, f, g, h, a, w[t + 7]);
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+  }
+}
+
+template <int Func>
+inline void sha1_round(uint32_t a, uint32_t &b, uint32_t c, uint32_t d, uint32_t &e, uint32_t w)
+{
+  static const uint32_t k[4] = {0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6};
+  uint32_t f;
+  if (Func == 0)
+    f = d ^ (b & (c ^ d));
+  else if (Func == 2)
+    f = (b & c) | (d & (b | c));
+  else
+    f = b ^ c ^ d;
+  e += rotl32(a, 5) + f + k[Func] + w;
+  b = rotl32(b, 30);
+}
+
+template <int Func>
+inline void sha1_rounds20(uint32_t *s, const uint32_t *w)
+{
+  for (size_t t = 20 * Func; t < 20 * Func + 20; t += 5)
+  {
+    sha1_round<Func>(s[0], s[1], s[2], s[3], s[4], w[t]);
+    sha1_round<Func>(s[4], s[0], s[1], s[2], s[3], w[t + 1]);
+    sha1_round<Func>(s[3], s[4], s[0], s[1], s[2], w[t + 2]);
+    sha1_round<Func>(s[2], s[3], s[4], s[0], s[1], w[t + 3]);
+    sha1_round<Func>(s[1], s[2], s[3], s[4], s[0], w[t + 4]);
+  }
+}
+
+void sha1_portable(uint32_t *state, const unsigned char *blocks, size_t count)
+{
+  for (size_t n = 0; n < count; ++n)
+  {
+    const unsigned char *p = blocks + block_size * n;
+    uint32_t w[80];
+    for (size_t t = 0; t < 16; ++t) w[t] = load_be32(p + 4 * t);
+    for (size_t t = 16; t < 80; ++t) w[t] = rotl32(w[t - 3] ^ w[t - 8] ^ w[t - 14] ^ w[t - 16], 1);
+
+    uint32_t s[5] = {state[0], state[1], state[2], state[3], state[4]};
+    sha1_rounds20<0>(s, w);
+    sha1_rounds20<1>(s, w);
+    sha1_rounds20<2>(s, w);
+    sha1_rounds20<3>(s, w);
+    for (size_t i = 0; i < 5; ++i) state[i] += s[i];
+  }
+}
+
+template <int Func, int S>
+inline void md5_step(uint32_t &a, uint32_t b, uint32_t c, uint32_t d, uint32_t km)
+{
+  uint32_t f;
+  if (Func == 0)
+    f = d ^ (b & (c ^ d));
+  else if (Func == 1)
+    f = c ^ (d & (b ^ c));
+  else if (Func == 2)
+    f = b ^ c ^ d;
+  else
+    f = c ^ (b | ~d);
+  a = b + rotl32(a + f + km, S);
+}
+
+// 一轮 16 步; 第 i 步使用消息字 (first + step * i) % 16
+template <int Func, int S0, int S1, int S2, int S3>
+inline void md5_round(uint32_t *s, const uint32_t *m, size_t first, size_t step)
+{
+  const uint32_t *k = detail::md5_k + 16 * Func;
+  for (size_t i = 0; i < 16; i += 4)
+  {
+    md5_step<Func, S0>(s[0], s[1], s[2], s[3], k[i] + m[(first + step * i) & 15]);
+    md5_step<Func, S1>(s[3], s[0], s[1], s[2], k[i + 1] + m[(first + step * (i + 1)) & 15]);
+    md5_step<Func, S2>(s[2], s[3], s[0], s[1], k[i + 2] + m[(first + step * (i + 2)) & 15]);
+    md5_step<Func, S3>(s[1], s[2], s[3], s[0], k[i + 3] + m[(first + step * (i + 3)) & 15]);
+  }
+}
+
+void md5_portable(uint32_t *state, const unsigned char *blocks, size_t count)
+{
+  for (size_t n = 0; n < count; ++n)
+  {
+    const unsigned char *p = blocks + block_size * n;
+    uint32_t m[16];
+    for (size_t i = 0; i < 16; ++i) m[i] = load_le32(p + 4 * i);
+
+    uint32_t s[4] = {state[0], state[1], state[2], state[3]};
+    md5_round<0, 7, 12, 17, 22>(s, m, 0, 1);
+    md5_round<1, 5, 9, 14, 20>(s, m, 1, 5);
+    md5_round<2, 4, 11, 16, 23>(s, m, 5, 3);
+    md5_round<3, 6, 10, 15, 21>(s, m, 0, 7);
+    for (size_t i = 0; i < 4; ++i) state[i] += s[i];
+  }
+}
+
+// ---------------- 算法描述与内核分派 ----------------
+detail::block_kernel select_sha256_kernel()
+{
+#if UTILS_X86_SIMD
+  const cpu::feature_set &f = cpu::features();
+  if (f.sha && f.ssse3 && f.sse41) return detail::sha256_shani;
+#endif  // UTILS_X86_SIMD
+  return sha256_portable;
+}
+
+detail::block_kernel select_sha1_kernel()
+{
+#if UTILS_X86_SIMD
+  const cpu::feature_set &f = cpu::features();
+  if (f.sha && f.ssse3 && f.sse41) return detail::sha1_shani;
+#endif  // UTILS_X86_SIMD
+  return sha1_portable;
+}
+
+// SHA-NI 逐条计算已快于 8 条消息并行的 AVX2 内核, 有 SHA-NI 时不使用多消息内核
+detail::multi_block_kernel select_sha256_multi_kernel()
+{
+#if UTILS_X86_SIMD
+  const cpu::feature_set &f = cpu::features();
+  if (f.avx2 && !f.sha) return detail::sha256_x8_avx2;
+#endif  // UTILS_X86_SIMD
+  return nullptr;
+}
+
+detail::multi_block_kernel select_sha1_multi_kernel()
+{
+#if UTILS_X86_SIMD
+  const cpu::feature_set &f = cpu::features();
+  if (f.avx2 && !f.sha) return detail::sha1_x8_avx2;
+#endif  // UTILS_X86_SIMD
+  return nullptr;
+}
+
+detail::multi_block_kernel select_md5_multi_kernel()
+{
+#if UTILS_X86_SIMD
+  if (cpu::features().avx2) return detail::md5_x8_avx2;
+#endif  // UTILS_X86_SIMD
+  return nullptr;
+}
+
+struct sha256_algo
+{
+  static const size_t words = 8;
+  static const size_t digest_size = 32;
+  static const bool big_endian = true;
+  using digest = sha256_digest;
+
+  static void init(uint32_t *h)
+  {
+    static const uint32_t iv[words] = {0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+                                       0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19};
+    std::memcpy(h, iv, sizeof(iv));
+  }
+
+  static void compress(uint32_t *h, const unsigned char *blocks, size_t count)
+  {
+    static const detail::block_kernel kernel = select_sha256_kernel();
+    kernel(h, blocks, count);
+  }
+
+  static detail::multi_block_kernel multi_kernel()
+  {
+    static const detail::multi_block_kernel kernel = select_sha256_multi_kernel();
+    return kernel;
+  }
+};
+
+struct sha1_algo
+{
+  static const size_t words = 5;
+  static const size_t digest_size = 20;
+  static const bool big_endian = true;
+  using digest = sha1_digest;
+
+  static void init(uint32_t *h)
+  {
+    static const uint32_t iv[words] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    std::memcpy(h, iv, sizeof(iv));
+  }
+
+  static void compress(uint32_t *h, const unsigned char *blocks, size_t count)
+  {
+    static const detail::block_kernel kernel = select_sha1_kernel();
+    kernel(h, blocks, count);
+  }
+
+  static detail::multi_block_kernel multi_kernel()
+  {
+    static const detail::multi_block_kernel kernel = select_sha1_multi_kernel();
+    return kernel;
+  }
+};
+
+struct md5_algo
+{
+  static const size_t words = 4;
+  static const size_t digest_size = 16;
+  static const bool big_endian = false;
+  using digest = md5_digest;
+
+  static void init(uint32_t *h)
+  {
+    static const uint32_t iv[words] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476};
+    std::memcpy(h, iv, sizeof(iv));
+  }
+
+  static void compress(uint32_t *h, const unsigned char *blocks, size_t count)
+  {
+    md5_portable(h, blocks, count);
+  }
+
+  static detail::multi_block_kernel multi_kernel()
+  {
+    static const detail::multi_block_kernel kernel = select_md5_multi_kernel();
+    return kernel;
+  }
+};
+
+// ---------------- 填充与输出 ----------------
+// 最后不足一块的 tail_len 字节加上填充, 写入 out (128 字节), 返回块数 (1 或 2)
+size_t pad_tail(const unsigned char *tail, size_t tail_len, uint64_t total_len, bool big_endian, unsigned char *out)
+{
+  const size_t blocks = tail_len < block_size - 8 ? 1 : 2;
+  const size_t size = blocks * block_size;
+  std::memcpy(out, tail, tail_len);
+  out[tail_len] = 0x80;
+  std::memset(out + tail_len + 1, 0, size - tail_len - 1);
+
+  const uint64_t bits = total_len * 8;
+  for (size_t i = 0; i < 8; ++i)
+  {
+    const unsigned int shift = big_endian ? static_cast<unsigned int>(56 - 8 * i) : static_cast<unsigned int>(8 * i);
+    out[size - 8 + i] = static_cast<unsigned char>(bits >> shift);
+  }
+  return blocks;
+}
+
+// 链接值的前 digest_size 字节即为摘要; stride 为相邻两个字在 h 中的间隔
+template <typename Algo>
+void store_digest(const uint32_t *h, size_t stride, uint8_t *out)
+{
+  for (size_t i = 0; i < Algo::digest_size / 4; ++i)
+  {
+    const uint32_t v = h[i * stride];
+    for (size_t j = 0; j < 4; ++j)
+    {
+      const unsigned int shift = Algo::big_endian ? static_cast<unsigned int>(24 - 8 * j) : static_cast<unsigned int>(8 * j);
+      out[4 * i + j] = static_cast<uint8_t>(v >> shift);
+    }
+  }
+}
+
+// ---------------- 流式计算 ----------------
+template <typename Algo>
+void block_reset(detail::block_state<Algo::words> &s)
+{
+  Algo::init(s.h);
+  s.buffered = 0;
+  s.total_len = 0;
+}
+
+template <typename Algo>
+void block_update(detail::block_state<Algo::words> &s, const unsigned char *p, size_t len)
+{
+  s.total_len += len;
+  if (s.buffered != 0)
+  {
+    const size_t fill = std::min(block_size - s.buffered, len);
+    std::memcpy(s.buffer + s.buffered, p, fill);
+    s.buffered += fill;
+    p += fill;
+    len -= fill;
+    if (s.buffered < block_size) return;
+    Algo::compress(s.h, s.buffer, 1);
+    s.buffered = 0;
+  }
+
+  // 完整的块直接从输入计算, 不经过缓冲区
+  const size_t blocks = len / block_size;
+  if (blocks != 0) Algo::compress(s.h, p, blocks);
+  s.buffered = len - blocks * block_size;
+  if (s.buffered != 0) std::memcpy(s.buffer, p + blocks * block_size, s.buffered);
+}
+
+template <typename Algo>
+typename Algo::digest block_final(const detail::block_state<Algo::words> &s)
+{
+  uint32_t h[Algo::words];
+  std::memcpy(h, s.h, sizeof(h));
+  unsigned char tail[2 * block_size];
+  Algo::compress(h, tail, pad_tail(s.buffer, s.buffered, s.total_len, Algo::big_endian, tail));
+
+  typename Algo::digest result;
+  store_digest<Algo>(h, 1, result.data());
+  return result;
+}
+
+template <typename Algo>
+void block_digest(const unsigned char *p, size_t len, uint8_t *out)
+{
+  uint32_t h[Algo::words];
+  Algo::init(h);
+  const size_t blocks = len / block_size;
+  if (blocks != 0) Algo::compress(h, p, blocks);
+
+  unsigned char tail[2 * block_size];
+  const size_t done = blocks * block_size;
+  Algo::compress(h, tail, pad_tail(p + done, len - done, len, Algo::big_endian, tail));
+  store_digest<Algo>(h, 1, out);
+}
+
+// ---------------- 多条消息 ----------------
+// 每条消息先计算输入中的完整块, 再计算 tail 中填充后的 1 ~ 2 块
+struct lane
+{
+  size_t message;
+  const unsigned char *data;  // 当前一段的下一块
+  size_t blocks;              // 当前一段剩余的块数
+  bool in_tail;
+  unsigned char tail[2 * block_size];
+};
+
+template <typename Algo>
+void digest_many(const unsigned char *const *data, const size_t *lens, size_t count, typename Algo::digest *out)
+{
+  const detail::multi_block_kernel kernel = Algo::multi_kernel();
+  const size_t min_active = 3;
+  if (kernel == nullptr || count < min_active)
+  {
+    for (size_t i = 0; i < count; ++i) block_digest<Algo>(data[i], lens[i], out[i].data());
+    return;
+  }
+
+  const size_t lanes_count = detail::digest_lanes;
+  uint32_t state[Algo::words * lanes_count] = {};  // 空闲 lane 也会被内核读写
+  lane lanes[lanes_count];
+  bool active[lanes_count] = {};
+  size_t active_count = 0;
+  size_t next = 0;
+
+  auto enter_tail = [&](lane &l) {
+    const size_t len = lens[l.message];
+    const size_t done = len / block_size * block_size;
+    l.blocks = pad_tail(data[l.message] + done, len - done, len, Algo::big_endian, l.tail);
+    l.data = l.tail;
+    l.in_tail = true;
+  };
+  auto start = [&](size_t i) {
+    if (next == count)
+    {
+      active[i] = false;
+      --active_count;
+      return;
+    }
+    lane &l = lanes[i];
+    l.message = next++;
+    l.data = data[l.message];
+    l.blocks = lens[l.message] / block_size;
+    l.in_tail = false;
+    if (l.blocks == 0) enter_tail(l);
+
+    uint32_t h[Algo::words];
+    Algo::init(h);
+    for (size_t w = 0; w < Algo::words; ++w) state[w * lanes_count + i] = h[w];
+  };
+
+  for (size_t i = 0; i < lanes_count; ++i)
+  {
+    active[i] = true;
+    ++active_count;
+    start(i);
+  }
+
+  while (active_count >= min_active)
+  {
+    size_t blocks = ~static_cast<size_t>(0);
+    const unsigned char *idle = nullptr;
+    for (size_t i = 0; i < lanes_count; ++i)
+    {
+      if (!active[i]) continue;
+      blocks = std::min(blocks, lanes[i].blocks);
+      idle = lanes[i].data;
+    }
+
+    // 空闲的 lane 重复计算某个活动 lane 的数据, 结果丢弃
+    const unsigned char *ptrs[lanes_count];
+    for (size_t i = 0; i < lanes_count; ++i) ptrs[i] = active[i] ? lanes[i].data : idle;
+    kernel(state, ptrs, blocks);
+
+    for (size_t i = 0; i < lanes_count; ++i)
+    {
+      if (!active[i]) continue;
+      lane &l = lanes[i];
+      l.data += blocks * block_size;
+      l.blocks -= blocks;
+      if (l.blocks != 0) continue;
+      if (!l.in_tail)
+      {
+        enter_tail(l);
+        continue;
+      }
+      store_digest<Algo>(state + i, lanes_count, out[l.message].data());
+      start(i);
+    }
+  }
+
+  // 剩余的消息逐条计算
+  for (size_t i = 0; i < lanes_count; ++i)
+  {
+    if (!active[i]) continue;
+    lane &l = lanes[i];
+    uint32_t h[Algo::words];
+    for (size_t w = 0; w < Algo::words; ++w) h[w] = state[w * lanes_count + i];
+    Algo::compress(h, l.data, l.blocks);
+    if (!l.in_tail)
+    {
+      enter_tail(l);
+      Algo::compress(h, l.data, l.blocks);
+    }
+    store_digest<Algo>(h, 1, out[l.message].data());
+  }
+  for (; next < count; ++next) block_digest<Algo>(data[next], lens[next], out[next].data());
+}
+
+template <typename Algo>
+std::vector<typename Algo::digest> digest_strings(const std::vector<std::string> &messages)
+{
+  std::vector<const unsigned char *> data(messages.size());
+  std::vector<size_t> lens(messages.size());
+  for (size_t i = 0; i < messages.size(); ++i)
+  {
+    data[i] = reinterpret_cast<const unsigned char *>(messages[i].data());
+    lens[i] = messages[i].size();
+  }
+
+  std::vector<typename Algo::digest> result(messages.size());
+  if (!messages.empty()) digest_many<Algo>(data.data(), lens.data(), messages.size(), result.data());
+  return result;
+}
+
+// ---------------- 文件 ----------------
+template <typename Algo>
+typename Algo::digest digest_file(const std::string &filepath, size_t buffer_size)
+{
+  typename Algo::digest result{};
+  fileio::file_reader file(filepath, buffer_size);
+  if (!file.is_open()) return result;
+
+  detail::block_state<Algo::words> state;
+  block_reset<Algo>(state);
+  const unsigned char *data = nullptr;
+  size_t len = 0;
+  while (file.next(data, len)) block_update<Algo>(state, data, len);
+  if (!file.failed()) result = block_final<Algo>(state);
+  return result;
+}
+
+// 一次打开一批文件: 整个文件作为一块返回的 (内存映射或小于缓冲区) 放在一起按多条消息计算,
+// 其余的逐个流式计算
+template <typename Algo>
+std::vector<typename Algo::digest> digest_files(const std::vector<std::string> &filepaths, size_t buffer_size)
+{
+  static const size_t batch = 64;
+  static const unsigned char empty = 0;
+
+  std::vector<typename Algo::digest> result(filepaths.size(), typename Algo::digest{});
+  for (size_t begin = 0; begin < filepaths.size(); begin += batch)
+  {
+    const size_t end = std::min(filepaths.size(), begin + batch);
+    std::vector<std::unique_ptr<fileio::file_reader>> files;
+    std::vector<const unsigned char *> data;
+    std::vector<size_t> lens;
+    std::vector<size_t> index;
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      uint64_t size = 0;
+      if (!fileio::file_size(filepaths[i], size)) continue;
+      std::unique_ptr<fileio::file_reader> file = utils::make_unique<fileio::file_reader>(filepaths[i], buffer_size);
+      if (!file->is_open()) continue;
+
+      const unsigned char *chunk = nullptr;
+      size_t len = 0;
+      const bool got = file->next(chunk, len);
+      if (file->failed()) continue;
+      if (!got || len == size)
+      {
+        data.push_back(got ? chunk : &empty);
+        lens.push_back(got ? len : 0);
+        index.push_back(i);
+        files.push_back(std::move(file));
+        continue;
+      }
+
+      detail::block_state<Algo::words> state;
+      block_reset<Algo>(state);
+      do
+      {
+        block_update<Algo>(state, chunk, len);
+      } while (file->next(chunk, len));
+      if (!file->failed()) result[i] = block_final<Algo>(state);
+    }
+
+    std::vector<typename Algo::digest> digests(index.size());
+    if (!index.empty()) digest_many<Algo>(data.data(), lens.data(), index.size(), digests.data());
+    for (size_t j = 0; j < index.size(); ++j) result[index[j]] = digests[j];
+  }
+  return result;
+}
+
+const unsigned char *bytes(const void *data)
+{
+  return static_cast<const unsigned char *>(data);
+}
+
+template <typename Algo>
+typename Algo::digest digest_string(const std::string &data)
+{
+  typename Algo::digest result;
+  block_digest<Algo>(bytes(data.data()), data.size(), result.data());
+  return result;
+}
+}  // namespace
+
+// ---------------- SHA-256 ----------------
+sha256_digest sha256(const std::string &data)
+{
+  return digest_string<sha256_algo>(data);
+}
+
+sha256_digest sha256_file(const std::string &filepath, size_t buffer_size)
+{
+  return digest_file<sha256_algo>(filepath, buffer_size);
+}
+
+std::vector<sha256_digest> sha256_many(const std::vector<std::string> &messages)
+{
+  return digest_strings<sha256_algo>(messages);
+}
+
+std::vector<sha256_digest> sha256_files(const std::vector<std::string> &filepaths, size_t buffer_size)
+{
+  return digest_files<sha256_algo>(filepaths, buffer_size);
+}
+
+sha256_hasher::sha256_hasher() noexcept
+{
+  reset();
+}
+
+void sha256_hasher::update(const void *data, size_t len)
+{
+  block_update<sha256_algo>(state_, bytes(data), len);
+}
+
+sha256_digest sha256_hasher::value() const noexcept
+{
+  return block_final<sha256_algo>(state_);
+}
+
+void sha256_hasher::reset() noexcept
+{
+  block_reset<sha256_algo>(state_);
+}
+
+// ---------------- SHA-1 ----------------
+sha1_digest sha1(const std::string &data)
+{
+  return digest_string<sha1_algo>(data);
+}
+
+sha1_digest sha1_file(const std::string &filepath, size_t buffer_size)
+{
+  return digest_file<sha1_algo>(filepath, buffer_size);
+}
+
+std::vector<sha1_digest> sha1_many(const std::vector<std::string> &messages)
+{
+  return digest_strings<sha1_algo>(messages);
+}
+
+std::vector<sha1_digest> sha1_files(const std::vector<std::string> &filepaths, size_t buffer_size)
+{
+  return digest_files<sha1_algo>(filepaths, buffer_size);
+}
+
+sha1_hasher::sha1_hasher() noexcept
+{
+  reset();
+}
+
+void sha1_hasher::update(const void *data, size_t len)
+{
+  block_update<sha1_algo>(state_, bytes(data), len);
+}
+
+sha1_digest sha1_hasher::value() const noexcept
+{
+  return block_final<sha1_algo>(state_);
+}
+
+void sha1_hasher::reset() noexcept
+{
+  block_reset<sha1_algo>(state_);
+}
+
+// ---------------- MD5 ----------------
+md5_digest md5(const std::string &data)
+{
+  return digest_string<md5_algo>(data);
+}
+
+md5_digest md5_file(const std::string &filepath, size_t buffer_size)
+{
+  return digest_file<md5_algo>(filepath, buffer_size);
+}
+
+std::vector<md5_digest> md5_many(const std::vector<std::string> &messages)
+{
+  return digest_strings<md5_algo>(messages);
+}
+
+std::vector<md5_digest> md5_files(const std::vector<std::string> &filepaths, size_t buffer_size)
+{
+  return digest_files<md5_algo>(filepaths, buffer_size);
+}
+
+md5_hasher::md5_hasher() noexcept
+{
+  reset();
+}
+
+void md5_hasher::update(const void *data, size_t len)
+{
+  block_update<md5_algo>(state_, bytes(data), len);
+}
+
+md5_digest md5_hasher::value() const noexcept
+{
+  return block_final<md5_algo>(state_);
+}
+
+void md5_hasher::reset() noexcept
+{
+  block_reset<md5_algo>(state_);
+}
+
+}  // namespace checkutils
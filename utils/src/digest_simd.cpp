@@ -0,0 +1,441 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file digest_simd.cpp
+ * @brief SHA-256 / SHA-1 的 SHA-NI 内核与 SHA-256 / SHA-1 / MD5 的 AVX2 多消息内核
+ *
+ * SHA-NI: 消息扩展与每 2 (SHA-256) / 4 (SHA-1) 轮由专用指令完成, 链接值以指令要求的
+ * ABEF/CDGH (SHA-256) 或逆序的 ABCD + E (SHA-1) 排列保存在寄存器中, 只在进出时转换.
+ *
+ * 多消息: 8 条消息各占一个 32 bit lane, 按标量算法逐轮计算. 每条消息一次读取 32 字节,
+ * 8 x 8 个字转置后每个向量即为 8 条消息的同一个字. 向量没有循环移位指令, 用两次移位与 or 完成.
+ *
+ * @author abin
+ * @date 2025-12-17
+ */
+
+#include "digest_simd.h"
+
+#if UTILS_X86_SIMD
+
+namespace checkutils
+{
+namespace detail
+{
+namespace
+{
+// ---------------- SHA-NI ----------------
+UTILS_TARGET("sha,ssse3,sse4.1") inline __m128i load_block_128(const unsigned char *p, __m128i mask)
+{
+  return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)), mask);
+}
+
+// SHA-256 第 4g ~ 4g+3 轮
+UTILS_TARGET("sha,ssse3,sse4.1") inline void sha256_rounds4(__m128i &abef, __m128i &cdgh, __m128i msg, int group)
+{
+  msg = _mm_add_epi32(msg, _mm_loadu_si128(reinterpret_cast<const __m128i *>(sha256_k + 4 * group)));
+  cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+  abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg, 0x0E));
+}
+
+// 由前 16 个字中的 4 组 (prev, cur 为最近的两组) 得到下一组消息字; next 已经过 sha256msg1
+UTILS_TARGET("sha,ssse3,sse4.1") inline __m128i sha256_next(__m128i next, __m128i prev, __m128i cur)
+{
+  next = _mm_add_epi32(next, _mm_alignr_epi8(cur, prev, 4));
+  return _mm_sha256msg2_epu32(next, cur);
+}
+
+// SHA-1 的 4 轮: e 为本组的 E (加上消息字后参与计算), 当前 abcd 留给下一组计算 E
+template <int Func>
+UTILS_TARGET("sha,ssse3,sse4.1") inline void sha1_rounds4(__m128i &abcd, __m128i &e, __m128i &next_e, __m128i msg)
+{
+  e = _mm_sha1nexte_epu32(e, msg);
+  next_e = abcd;
+  abcd = _mm_sha1rnds4_epu32(abcd, e, Func);
+}
+
+// SHA-1 消息扩展的流水: cur 用完后, next 完成, prev 开始, prev2 累积
+UTILS_TARGET("sha,ssse3,sse4.1") inline void sha1_schedule(__m128i &next, __m128i &prev, __m128i &prev2, __m128i cur)
+{
+  next = _mm_sha1msg2_epu32(next, cur);
+  prev = _mm_sha1msg1_epu32(prev, cur);
+  prev2 = _mm_xor_si128(prev2, cur);
+}
+
+// ---------------- AVX2 多消息 ----------------
+UTILS_TARGET("avx2") inline __m256i add(__m256i a, __m256i b)
+{
+  return _mm256_add_epi32(a, b);
+}
+
+template <int N>
+UTILS_TARGET("avx2") inline __m256i rotl(__m256i x)
+{
+  return _mm256_or_si256(_mm256_slli_epi32(x, N), _mm256_srli_epi32(x, 32 - N));
+}
+
+template <int N>
+UTILS_TARGET("avx2") inline __m256i rotr(__m256i x)
+{
+  return rotl<32 - N>(x);
+}
+
+// 8 条消息各取 32 字节 (8 个字), 转置为 8 个向量: 第 i 个向量为各条消息的第 i 个字
+UTILS_TARGET("avx2") void load_transposed(const unsigned char *const *data, size_t offset, __m256i *words)
+{
+  __m256i r[8];
+  for (size_t i = 0; i < 8; ++i) r[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data[i] + offset));
+
+  __m256i t[8];
+  for (size_t i = 0; i < 8; i += 2)
+  {
+    t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+    t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+  }
+  // u[0..3]: 消息 0~3 的字 0/4, 1/5, 2/6, 3/7; u[4..7]: 消息 4~7
+  __m256i u[8];
+  for (size_t i = 0; i < 8; i += 4)
+  {
+    u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+    u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+    u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+    u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+  }
+  for (size_t i = 0; i < 4; ++i)
+  {
+    words[i] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+    words[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+  }
+}
+
+// 一块 16 个字, big_endian 时按大端序读取 (SHA)
+UTILS_TARGET("avx2") void load_block_x8(const unsigned char *const *data, size_t offset, bool big_endian, __m256i *w)
+{
+  load_transposed(data, offset, w);
+  load_transposed(data, offset + 32, w + 8);
+  if (big_endian)
+  {
+    const __m256i mask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4,
+                                          11, 10, 9, 8, 15, 14, 13, 12);
+    for (size_t i = 0; i < 16; ++i) w[i] = _mm256_shuffle_epi8(w[i], mask);
+  }
+}
+
+UTILS_TARGET("avx2") void load_state_x8(const uint32_t *state, __m256i *s, size_t words)
+{
+  for (size_t i = 0; i < words; ++i) s[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state + 8 * i));
+}
+
+UTILS_TARGET("avx2") void add_state_x8(uint32_t *state, const __m256i *s, size_t words)
+{
+  for (size_t i = 0; i < words; ++i)
+  {
+    __m256i *p = reinterpret_cast<__m256i *>(state + 8 * i);
+    _mm256_storeu_si256(p, add(_mm256_loadu_si256(p), s[i]));
+  }
+}
+
+// SHA-256 一轮; 调用方轮换变量名代替 8 个变量的移动
+UTILS_TARGET("avx2")
+inline void sha256_round_x8(__m256i a, __m256i b, __m256i c, __m256i &d, __m256i e, __m256i f, __m256i g, __m256i &h,
+                            __m256i kw)
+{
+  const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr<6>(e), rotr<11>(e)), rotr<25>(e));
+  const __m256i ch = _mm256_xor_si256(g, _mm256_and_si256(e, _mm256_xor_si256(f, g)));
+  const __m256i t1 = add(add(h, s1), add(ch, kw));
+  const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr<2>(a), rotr<13>(a)), rotr<22>(a));
+  const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+  d = add(d, t1);
+  h = add(t1, add(s0, maj));
+}
+
+// W[t] (t >= 16), w 为 16 个字的环形缓冲
+UTILS_TARGET("avx2") inline __m256i sha256_schedule_x8(__m256i *w, size_t t)
+{
+  const __m256i w15 = w[(t - 15) & 15];
+  const __m256i w2 = w[(t - 2) & 15];
+  const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr<7>(w15), rotr<18>(w15)), _mm256_srli_epi32(w15, 3));
+  const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr<17>(w2), rotr<19>(w2)), _mm256_srli_epi32(w2, 10));
+  w[t & 15] = add(add(w[t & 15], s0), add(w[(t - 7) & 15], s1));
+  return w[t & 15];
+}
+
+// 第 t 轮的 K[t] + W[t]
+UTILS_TARGET("avx2") inline __m256i sha256_kw_x8(__m256i *w, size_t t)
+{
+  return add(_mm256_set1_epi32(static_cast<int>(sha256_k[t])), t < 16 ? w[t] : sha256_schedule_x8(w, t));
+}
+
+// SHA-1 一轮, 同样轮换变量名; Func 为 0 ~ 3 对应 4 组 20 轮
+template <int Func>
+UTILS_TARGET("avx2")
+inline void sha1_round_x8(__m256i a, __m256i &b, __m256i c, __m256i d, __m256i &e, __m256i kw)
+{
+  __m256i f;
+  if (Func == 0)
+    f = _mm256_xor_si256(d, _mm256_and_si256(b, _mm256_xor_si256(c, d)));
+  else if (Func == 2)
+    f = _mm256_or_si256(_mm256_and_si256(b, c), _mm256_and_si256(d, _mm256_or_si256(b, c)));
+  else
+    f = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+  e = add(add(e, rotl<5>(a)), add(f, kw));
+  b = rotl<30>(b);
+}
+
+// 第 t 轮的 K + W[t]
+UTILS_TARGET("avx2") inline __m256i sha1_kw_x8(__m256i *w, size_t t, __m256i k)
+{
+  if (t >= 16)
+  {
+    const __m256i x = _mm256_xor_si256(_mm256_xor_si256(w[(t - 3) & 15], w[(t - 8) & 15]),
+                                       _mm256_xor_si256(w[(t - 14) & 15], w[t & 15]));
+    w[t & 15] = rotl<1>(x);
+  }
+  return add(k, w[t & 15]);
+}
+
+template <int Func>
+UTILS_TARGET("avx2") void sha1_rounds20_x8(__m256i *s, __m256i *w, uint32_t k)
+{
+  const __m256i kv = _mm256_set1_epi32(static_cast<int>(k));
+  for (size_t t = 20 * Func; t < 20 * Func + 20; t += 5)
+  {
+    sha1_round_x8<Func>(s[0], s[1], s[2], s[3], s[4], sha1_kw_x8(w, t, kv));
+    sha1_round_x8<Func>(s[4], s[0], s[1], s[2], s[3], sha1_kw_x8(w, t + 1, kv));
+    sha1_round_x8<Func>(s[3], s[4], s[0], s[1], s[2], sha1_kw_x8(w, t + 2, kv));
+    sha1_round_x8<Func>(s[2], s[3], s[4], s[0], s[1], sha1_kw_x8(w, t + 3, kv));
+    sha1_round_x8<Func>(s[1], s[2], s[3], s[4], s[0], sha1_kw_x8(w, t + 4, kv));
+  }
+}
+
+// MD5 一步: a = b + rotl(a + f(b, c, d) + k + m, S)
+template <int Func, int S>
+UTILS_TARGET("avx2") inline void md5_step_x8(__m256i &a, __m256i b, __m256i c, __m256i d, __m256i km)
+{
+  __m256i f;
+  if (Func == 0)
+    f = _mm256_xor_si256(d, _mm256_and_si256(b, _mm256_xor_si256(c, d)));
+  else if (Func == 1)
+    f = _mm256_xor_si256(c, _mm256_and_si256(d, _mm256_xor_si256(b, c)));
+  else if (Func == 2)
+    f = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+  else
+    f = _mm256_xor_si256(c, _mm256_or_si256(b, _mm256_xor_si256(d, _mm256_set1_epi32(-1))));
+  a = add(b, rotl<S>(add(add(a, f), km)));
+}
+
+// 一轮 16 步; 第 i 步使用消息字 (first + step * i) % 16
+template <int Func>
+UTILS_TARGET("avx2") inline __m256i md5_km_x8(const __m256i *m, size_t i, size_t first, size_t step)
+{
+  return add(_mm256_set1_epi32(static_cast<int>(md5_k[16 * Func + i])), m[(first + step * i) & 15]);
+}
+
+template <int Func, int S0, int S1, int S2, int S3>
+UTILS_TARGET("avx2") void md5_round_x8(__m256i *s, const __m256i *m, size_t first, size_t step)
+{
+  for (size_t i = 0; i < 16; i += 4)
+  {
+    md5_step_x8<Func, S0>(s[0], s[1], s[2], s[3], md5_km_x8<Func>(m, i, first, step));
+    md5_step_x8<Func, S1>(s[3], s[0], s[1], s[2], md5_km_x8<Func>(m, i + 1, first, step));
+    md5_step_x8<Func, S2>(s[2], s[3], s[0], s[1], md5_km_x8<Func>(m, i + 2, first, step));
+    md5_step_x8<Func, S3>(s[1], s[2], s[3], s[0], md5_km_x8<Func>(m, i + 3, first, step));
+  }
+}
+}  // namespace
+
+// ---------------- SHA-NI ----------------
+UTILS_TARGET("sha,ssse3,sse4.1") void sha256_shani(uint32_t *state, const unsigned char *blocks, size_t count)
+{
+  const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+  // a b c d / e f g h -> ABEF / CDGH (高位在前)
+  const __m128i dcba = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state)), 0xB1);
+  const __m128i hgfe = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state + 4)), 0x1B);
+  __m128i abef = _mm_alignr_epi8(dcba, hgfe, 8);
+  __m128i cdgh = _mm_blend_epi16(hgfe, dcba, 0xF0);
+
+  for (size_t n = 0; n < count; ++n)
+  {
+    const unsigned char *p = blocks + 64 * n;
+    const __m128i abef_save = abef;
+    const __m128i cdgh_save = cdgh;
+
+    __m128i m0 = load_block_128(p, mask);
+    __m128i m1 = load_block_128(p + 16, mask);
+    __m128i m2 = load_block_128(p + 32, mask);
+    __m128i m3 = load_block_128(p + 48, mask);
+    sha256_rounds4(abef, cdgh, m0, 0);
+    sha256_rounds4(abef, cdgh, m1, 1);
+    m0 = _mm_sha256msg1_epu32(m0, m1);
+    sha256_rounds4(abef, cdgh, m2, 2);
+    m1 = _mm_sha256msg1_epu32(m1, m2);
+    sha256_rounds4(abef, cdgh, m3, 3);
+    m0 = sha256_next(m0, m2, m3);
+    m2 = _mm_sha256msg1_epu32(m2, m3);
+
+    // 最后一次循环多算的几组消息字不再使用
+    for (int g = 4; g < 16; g += 4)
+    {
+      sha256_rounds4(abef, cdgh, m0, g);
+      m1 = sha256_next(m1, m3, m0);
+      m3 = _mm_sha256msg1_epu32(m3, m0);
+      sha256_rounds4(abef, cdgh, m1, g + 1);
+      m2 = sha256_next(m2, m0, m1);
+      m0 = _mm_sha256msg1_epu32(m0, m1);
+      sha256_rounds4(abef, cdgh, m2, g + 2);
+      m3 = sha256_next(m3, m1, m2);
+      m1 = _mm_sha256msg1_epu32(m1, m2);
+      sha256_rounds4(abef, cdgh, m3, g + 3);
+      m0 = sha256_next(m0, m2, m3);
+      m2 = _mm_sha256msg1_epu32(m2, m3);
+    }
+
+    abef = _mm_add_epi32(abef, abef_save);
+    cdgh = _mm_add_epi32(cdgh, cdgh_save);
+  }
+
+  const __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+  const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(state), _mm_blend_epi16(feba, dchg, 0xF0));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+UTILS_TARGET("sha,ssse3,sse4.1") void sha1_shani(uint32_t *state, const unsigned char *blocks, size_t count)
+{
+  // 整个 16 字节逆序: 字节序转为大端, 同时第一个字放到最高位
+  const __m128i mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+  __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state)), 0x1B);
+  __m128i e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+  __m128i e1;
+
+  for (size_t n = 0; n < count; ++n)
+  {
+    const unsigned char *p = blocks + 64 * n;
+    const __m128i abcd_save = abcd;
+    const __m128i e_save = e0;
+
+    __m128i m0 = load_block_128(p, mask);
+    __m128i m1 = load_block_128(p + 16, mask);
+    __m128i m2 = load_block_128(p + 32, mask);
+    __m128i m3 = load_block_128(p + 48, mask);
+
+    e0 = _mm_add_epi32(e0, m0);
+    e1 = abcd;
+    abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+    sha1_rounds4<0>(abcd, e1, e0, m1);
+    m0 = _mm_sha1msg1_epu32(m0, m1);
+    sha1_rounds4<0>(abcd, e0, e1, m2);
+    m1 = _mm_sha1msg1_epu32(m1, m2);
+    m0 = _mm_xor_si128(m0, m2);
+    sha1_rounds4<0>(abcd, e1, e0, m3);
+    sha1_schedule(m0, m2, m1, m3);
+
+    sha1_rounds4<0>(abcd, e0, e1, m0);
+    sha1_schedule(m1, m3, m2, m0);
+    sha1_rounds4<1>(abcd, e1, e0, m1);
+    sha1_schedule(m2, m0, m3, m1);
+    sha1_rounds4<1>(abcd, e0, e1, m2);
+    sha1_schedule(m3, m1, m0, m2);
+    sha1_rounds4<1>(abcd, e1, e0, m3);
+    sha1_schedule(m0, m2, m1, m3);
+    sha1_rounds4<1>(abcd, e0, e1, m0);
+    sha1_schedule(m1, m3, m2, m0);
+    sha1_rounds4<1>(abcd, e1, e0, m1);
+    sha1_schedule(m2, m0, m3, m1);
+    sha1_rounds4<2>(abcd, e0, e1, m2);
+    sha1_schedule(m3, m1, m0, m2);
+    sha1_rounds4<2>(abcd, e1, e0, m3);
+    sha1_schedule(m0, m2, m1, m3);
+    sha1_rounds4<2>(abcd, e0, e1, m0);
+    sha1_schedule(m1, m3, m2, m0);
+    sha1_rounds4<2>(abcd, e1, e0, m1);
+    sha1_schedule(m2, m0, m3, m1);
+    sha1_rounds4<2>(abcd, e0, e1, m2);
+    sha1_schedule(m3, m1, m0, m2);
+    sha1_rounds4<3>(abcd, e1, e0, m3);
+    sha1_schedule(m0, m2, m1, m3);
+    sha1_rounds4<3>(abcd, e0, e1, m0);
+    sha1_schedule(m1, m3, m2, m0);
+    sha1_rounds4<3>(abcd, e1, e0, m1);
+    sha1_schedule(m2, m0, m3, m1);
+    sha1_rounds4<3>(abcd, e0, e1, m2);
+    sha1_schedule(m3, m1, m0, m2);
+    sha1_rounds4<3>(abcd, e1, e0, m3);
+
+    e0 = _mm_sha1nexte_epu32(e0, e_save);
+    abcd = _mm_add_epi32(abcd, abcd_save);
+  }
+
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(state), _mm_shuffle_epi32(abcd, 0x1B));
+  state[4] = static_cast<uint32_t>(_mm_extract_epi32(e0, 3));
+}
+
+// ---------------- AVX2 多消息 ----------------
+UTILS_TARGET("avx2") void sha256_x8_avx2(uint32_t *state, const unsigned char *const *data, size_t blocks)
+{
+  for (size_t n = 0; n < blocks; ++n)
+  {
+    __m256i w[16];
+    load_block_x8(data, 64 * n, true, w);
+    __m256i s[8];
+    load_state_x8(state, s, 8);
+
+    for (size_t t = 0; t < 64; t += 8)
+    {
+      sha256_round_x8(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], sha256_kw_x8(w, t));
+      sha256_round_x8(s[7], s[0], s[1], s[2], s[3], s[4], s[5], s[6], sha256_kw_x8(w, t + 1));
+      sha256_round_x8(s[6], s[7], s[0], s[1], s[2], s[3], s[4], s[5], sha256_kw_x8(w, t + 2));
+      sha256_round_x8(s[5], s[6], s[7], s[0], s[1], s[2], s[3], s[4], sha256_kw_x8(w, t + 3));
+      sha256_round_x8(s[4], s[5], s[6], s[7], s[0], s[1], s[2], s[3], sha256_kw_x8(w, t + 4));
+      sha256_round_x8(s[3], s[4], s[5], s[6], s[7], s[0], s[1], s[2], sha256_kw_x8(w, t + 5));
+      sha256_round_x8(s[2], s[3], s[4], s[5], s[6], s[7], s[0], s[1], sha256_kw_x8(w, t + 6));
+      sha256_round_x8(s[1], s[2], s[3], s[4], s[5], s[6], s[7], s[0], sha256_kw_x8(w, t + 7));
+    }
+    add_state_x8(state, s, 8);
+  }
+  _mm256_zeroupper();
+}
+
+UTILS_TARGET("avx2") void sha1_x8_avx2(uint32_t *state, const unsigned char *const *data, size_t blocks)
+{
+  for (size_t n = 0; n < blocks; ++n)
+  {
+    __m256i w[16];
+    load_block_x8(data, 64 * n, true, w);
+    __m256i s[5];
+    load_state_x8(state, s, 5);
+
+    sha1_rounds20_x8<0>(s, w, 0x5A827999);
+    sha1_rounds20_x8<1>(s, w, 0x6ED9EBA1);
+    sha1_rounds20_x8<2>(s, w, 0x8F1BBCDC);
+    sha1_rounds20_x8<3>(s, w, 0xCA62C1D6);
+    add_state_x8(state, s, 5);
+  }
+  _mm256_zeroupper();
+}
+
+UTILS_TARGET("avx2") void md5_x8_avx2(uint32_t *state, const unsigned char *const *data, size_t blocks)
+{
+  for (size_t n = 0; n < blocks; ++n)
+  {
+    __m256i m[16];
+    load_block_x8(data, 64 * n, false, m);
+    __m256i s[4];
+    load_state_x8(state, s, 4);
+
+    md5_round_x8<0, 7, 12, 17, 22>(s, m, 0, 1);
+    md5_round_x8<1, 5, 9, 14, 20>(s, m, 1, 5);
+    md5_round_x8<2, 4, 11, 16, 23>(s, m, 5, 3);
+    md5_round_x8<3, 6, 10, 15, 21>(s, m, 0, 7);
+    add_state_x8(state, s, 4);
+  }
+  _mm256_zeroupper();
+}
+
+}  // namespace detail
+}  // namespace checkutils
+
+#endif  // UTILS_X86_SIMD
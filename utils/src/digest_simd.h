@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file digest_simd.h
+ * @brief SHA-256 / SHA-1 / MD5 压缩函数的硬件加速内核（库内部使用，由 digest.cpp 在运行时按 CPU 特性分派）
+ *
+ * 单消息内核对连续的 count 个 64 字节块更新链接值 state (按算法的字序, 即 a, b, c, ...).
+ * 多消息内核同时更新 8 条消息: state 按 [字][lane] 排列 (第 w 个字的 8 个 lane 连续存放),
+ * 每个 lane 从 data[lane] 开始读取 blocks 个连续的块.
+ *
+ * @author abin
+ * @date 2025-12-17
+ */
+
+#ifndef __GUARD_DIGEST_SIMD_H_INCLUDE_GUARD__
+#define __GUARD_DIGEST_SIMD_H_INCLUDE_GUARD__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cpu_features.h"
+
+namespace checkutils
+{
+namespace detail
+{
+
+const size_t digest_lanes = 8;
+
+// 轮常量, 定义在 digest.cpp
+extern const uint32_t sha256_k[64];
+extern const uint32_t md5_k[64];
+
+using block_kernel = void (*)(uint32_t *state, const unsigned char *blocks, size_t count);
+using multi_block_kernel = void (*)(uint32_t *state, const unsigned char *const *data, size_t blocks);
+
+#if UTILS_X86_SIMD
+// SHA 扩展指令 (sha256rnds2 / sha1rnds4 等), 还需要 SSSE3 与 SSE4.1
+void sha256_shani(uint32_t *state, const unsigned char *blocks, size_t count);
+void sha1_shani(uint32_t *state, const unsigned char *blocks, size_t count);
+
+// AVX2: 每个 32 bit lane 计算一条消息
+void sha256_x8_avx2(uint32_t *state, const unsigned char *const *data, size_t blocks);
+void sha1_x8_avx2(uint32_t *state, const unsigned char *const *data, size_t blocks);
+void md5_x8_avx2(uint32_t *state, const unsigned char *const *data, size_t blocks);
+#endif  // UTILS_X86_SIMD
+
+}  // namespace detail
+}  // namespace checkutils
+
+#endif  // __GUARD_DIGEST_SIMD_H_INCLUDE_GUARD__
@@ -0,0 +1,208 @@
+#include "file_io.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(_WIN32)
+#include <sys/stat.h>
+#include <sys/types.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+namespace fileio
+{
+
+namespace
+{
+// 按块读取的缓冲区按页对齐, 便于内核直接拷贝整页
+constexpr size_t buffer_alignment = 4096;
+}  // namespace
+
+constexpr size_t file_reader::default_buffer_size;
+constexpr uint64_t file_reader::to_end;
+
+file_reader::file_reader(const std::string &path, size_t buffer_size) :
+  file_reader(path, buffer_size, 0, to_end)
+{
+}
+
+unsigned char *file_reader::buffer()
+{
+  if (buffer_.empty()) buffer_.resize(buffer_size_ + buffer_alignment);
+  const uintptr_t address = reinterpret_cast<uintptr_t>(buffer_.data());
+  return buffer_.data() + (buffer_alignment - address % buffer_alignment) % buffer_alignment;
+}
+
+#if defined(_WIN32)
+file_reader::file_reader(const std::string &path, size_t buffer_size, uint64_t offset, uint64_t length) :
+  buffer_size_(buffer_size != 0 ? buffer_size : default_buffer_size),
+  remaining_(length)
+{
+  file_ = std::fopen(path.c_str(), "rb");
+  if (file_ == nullptr) return;
+
+  std::setvbuf(file_, nullptr, _IONBF, 0);
+  if (offset != 0 && _fseeki64(file_, static_cast<long long>(offset), SEEK_SET) != 0) failed_ = true;
+}
+
+file_reader::~file_reader()
+{
+  if (file_ != nullptr) std::fclose(file_);
+}
+
+bool file_reader::is_open() const
+{
+  return file_ != nullptr;
+}
+
+bool file_reader::next(const unsigned char *&data, size_t &len)
+{
+  if (file_ == nullptr || failed_ || remaining_ == 0) return false;
+
+  unsigned char *buf = buffer();
+  len = std::fread(buf, 1, static_cast<size_t>(std::min<uint64_t>(buffer_size_, remaining_)), file_);
+  if (len == 0)
+  {
+    failed_ = std::ferror(file_) != 0;
+    return false;
+  }
+
+  remaining_ -= len;
+  data = buf;
+  return true;
+}
+
+bool file_size(const std::string &path, uint64_t &size)
+{
+  struct _stat64 st;
+  if (_stat64(path.c_str(), &st) != 0) return false;
+  size = static_cast<uint64_t>(st.st_size);
+  return true;
+}
+#else
+file_reader::file_reader(const std::string &path, size_t buffer_size, uint64_t offset, uint64_t length) :
+  buffer_size_(buffer_size != 0 ? buffer_size : default_buffer_size),
+  remaining_(length)
+{
+  fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd_ < 0) return;
+
+  // 普通文件映射所需范围; 映射失败 (如 32 位地址空间不足) 时按块读取
+  struct stat st;
+  if (::fstat(fd_, &st) == 0 && S_ISREG(st.st_mode))
+  {
+    const uint64_t file_size = static_cast<uint64_t>(st.st_size);
+    remaining_ = offset < file_size ? std::min(remaining_, file_size - offset) : 0;
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+    ::posix_fadvise(fd_, static_cast<off_t>(offset), static_cast<off_t>(remaining_), POSIX_FADV_SEQUENTIAL);
+#endif
+
+    static const uint64_t page_size = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+    const uint64_t map_offset = offset - offset % page_size;
+    const uint64_t map_size = remaining_ + (offset - map_offset);
+    if (remaining_ > 0 && map_size <= static_cast<size_t>(-1))
+    {
+      void *map = ::mmap(nullptr, static_cast<size_t>(map_size), PROT_READ, MAP_PRIVATE, fd_,
+                         static_cast<off_t>(map_offset));
+      if (map != MAP_FAILED)
+      {
+        map_ = map;
+        map_size_ = static_cast<size_t>(map_size);
+        map_skip_ = static_cast<size_t>(offset - map_offset);
+#if defined(MADV_SEQUENTIAL)
+        ::madvise(map_, map_size_, MADV_SEQUENTIAL);
+#endif
+        return;
+      }
+    }
+  }
+
+  if (offset != 0 && ::lseek(fd_, static_cast<off_t>(offset), SEEK_SET) < 0) failed_ = true;
+}
+
+file_reader::~file_reader()
+{
+  if (map_ != nullptr) ::munmap(map_, map_size_);
+  if (fd_ >= 0) ::close(fd_);
+}
+
+bool file_reader::is_open() const
+{
+  return fd_ >= 0;
+}
+
+bool file_reader::next(const unsigned char *&data, size_t &len)
+{
+  if (fd_ < 0 || failed_ || remaining_ == 0) return false;
+
+  if (map_ != nullptr)
+  {
+    // 映射只作为一个块返回一次
+    if (map_consumed_) return false;
+    data = static_cast<const unsigned char *>(map_) + map_skip_;
+    len = map_size_ - map_skip_;
+    map_consumed_ = true;
+    return true;
+  }
+
+  unsigned char *buf = buffer();
+  for (;;)
+  {
+    const ssize_t n = ::read(fd_, buf, static_cast<size_t>(std::min<uint64_t>(buffer_size_, remaining_)));
+    if (n > 0)
+    {
+      remaining_ -= static_cast<uint64_t>(n);
+      data = buf;
+      len = static_cast<size_t>(n);
+      return true;
+    }
+    if (n < 0 && errno == EINTR) continue;
+
+    failed_ = n < 0;
+    return false;
+  }
+}
+
+bool file_size(const std::string &path, uint64_t &size)
+{
+  struct stat st;
+  if (::stat(path.c_str(), &st) != 0) return false;
+  size = static_cast<uint64_t>(st.st_size);
+  return true;
+}
+#endif  // _WIN32
+
+file_writer::file_writer(const std::string &path)
+{
+  file_ = std::fopen(path.c_str(), "wb");
+  if (file_ != nullptr) std::setvbuf(file_, nullptr, _IONBF, 0);
+}
+
+file_writer::~file_writer()
+{
+  close();
+}
+
+bool file_writer::write(const void *data, size_t len)
+{
+  if (file_ == nullptr || failed_) return false;
+  if (len != 0 && std::fwrite(data, 1, len, file_) != len) failed_ = true;
+  return !failed_;
+}
+
+bool file_writer::close()
+{
+  if (file_ == nullptr) return false;
+  if (std::fclose(file_) != 0) failed_ = true;
+  file_ = nullptr;
+  return !failed_;
+}
+
+}  // namespace fileio
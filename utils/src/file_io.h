@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file file_io.h
+ * @brief 顺序读写整个文件的辅助类（库内部使用，不对外安装）
+ *
+ * file_reader 对普通文件使用内存映射, 整个文件 (或指定范围) 作为一个块返回, 没有拷贝;
+ * 无法映射时 (管道、设备文件、空文件、Windows) 退回到页对齐缓冲区的按块读取.
+ * 两种方式都向内核提示顺序访问 (posix_fadvise / madvise), 以获得更大的预读.
+ * file_writer 不经过 stdio 缓冲, 直接写出调用方提供的大块数据.
+ *
+ * @author abin
+ * @date 2025-12-08
+ */
+
+#ifndef __GUARD_FILE_IO_H_INCLUDE_GUARD__
+#define __GUARD_FILE_IO_H_INCLUDE_GUARD__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace fileio
+{
+
+class file_reader
+{
+ public:
+  static constexpr size_t default_buffer_size = 1 << 20;
+  static constexpr uint64_t to_end = ~static_cast<uint64_t>(0);
+
+  // buffer_size 为按块读取时每块的大小, 0 表示 default_buffer_size
+  explicit file_reader(const std::string &path, size_t buffer_size = default_buffer_size);
+
+  // 只读取 [offset, offset + length) 范围 (不超过文件末尾), 用于多线程分段处理
+  file_reader(const std::string &path, size_t buffer_size, uint64_t offset, uint64_t length);
+  ~file_reader();
+
+  file_reader(const file_reader &) = delete;
+  file_reader &operator=(const file_reader &) = delete;
+
+  bool is_open() const;
+
+  // 取下一块数据, 在下次调用 next() 或析构前有效. 文件结束或出错时返回 false
+  bool next(const unsigned char *&data, size_t &len);
+
+  // 读取过程中是否出错 (next() 返回 false 之后用于区分文件结束)
+  bool failed() const
+  {
+    return failed_;
+  }
+
+ private:
+  unsigned char *buffer();
+
+#if defined(_WIN32)
+  std::FILE *file_ = nullptr;
+#else
+  int fd_ = -1;
+  void *map_ = nullptr;
+  size_t map_size_ = 0;
+  size_t map_skip_ = 0;  // 映射起点按页对齐后, 范围起点在映射中的偏移
+  bool map_consumed_ = false;
+#endif
+  std::vector<unsigned char> buffer_;
+  size_t buffer_size_;
+  uint64_t remaining_;
+  bool failed_ = false;
+};
+
+// 文件大小, 无法获取时返回 false
+bool file_size(const std::string &path, uint64_t &size);
+
+class file_writer
+{
+ public:
+  explicit file_writer(const std::string &path);
+  ~file_writer();
+
+  file_writer(const file_writer &) = delete;
+  file_writer &operator=(const file_writer &) = delete;
+
+  bool is_open() const
+  {
+    return file_ != nullptr;
+  }
+
+  bool write(const void *data, size_t len);
+
+  // 关闭文件, 返回此前的所有写入是否都成功
+  bool close();
+
+ private:
+  std::FILE *file_ = nullptr;
+  bool failed_ = false;
+};
+
+}  // namespace fileio
+
+#endif  // __GUARD_FILE_IO_H_INCLUDE_GUARD__
@@ -0,0 +1,233 @@
+#include "utils/hex.h"
+
+#include <cstring>
+
+#include "cpu_features.h"
+
+namespace codec
+{
+
+hex_error::hex_error(size_t position) :
+  std::runtime_error("Invalid hexadecimal data (at offset " + std::to_string(position) + ")"),
+  position_(position)
+{
+}
+
+// ---------------- 内核 ----------------
+// 内核只处理整块数据, 返回已消耗的输入长度; 解码内核遇到含非法字符的块即停止, 由标量代码定位
+namespace
+{
+using encode_kernel = size_t (*)(const unsigned char *in, size_t len, char *out, bool uppercase);
+using decode_kernel = size_t (*)(const char *in, size_t len, unsigned char *out);
+
+#if UTILS_X86_SIMD
+UTILS_TARGET("ssse3") inline __m128i digits_128(bool uppercase)
+{
+  return uppercase ? _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F')
+                   : _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+}
+
+// 16 字节 -> 32 个字符
+UTILS_TARGET("ssse3") size_t encode_ssse3(const unsigned char *in, size_t len, char *out, bool uppercase)
+{
+  const __m128i digits = digits_128(uppercase);
+  const __m128i nibble = _mm_set1_epi8(0x0f);
+  size_t pos = 0;
+  for (; len - pos >= 16; pos += 16)
+  {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + pos));
+    const __m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+    const __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(v, nibble));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * pos), _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * pos + 16), _mm_unpackhi_epi8(hi, lo));
+  }
+  return pos;
+}
+
+// 32 字节 -> 64 个字符
+UTILS_TARGET("avx2") size_t encode_avx2(const unsigned char *in, size_t len, char *out, bool uppercase)
+{
+  const __m256i digits = _mm256_broadcastsi128_si256(digits_128(uppercase));
+  const __m256i nibble = _mm256_set1_epi8(0x0f);
+  size_t pos = 0;
+  for (; len - pos >= 32; pos += 32)
+  {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + pos));
+    const __m256i hi = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+    const __m256i lo = _mm256_shuffle_epi8(digits, _mm256_and_si256(v, nibble));
+    // unpack 在每个 128 bit 通道内进行, 再按通道重新组合
+    const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+    const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 2 * pos), _mm256_permute2x128_si256(a, b, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 2 * pos + 32), _mm256_permute2x128_si256(a, b, 0x31));
+  }
+  _mm256_zeroupper();
+  return pos + encode_ssse3(in + pos, len - pos, out + 2 * pos, uppercase);
+}
+
+// 16 个字符 -> 16 个 4 bit 值; 含非法字符时返回 false
+UTILS_TARGET("ssse3") inline bool values_128(__m128i v, __m128i &values)
+{
+  const __m128i digit = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+  const __m128i letter = _mm_sub_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+  const __m128i minus_one = _mm_set1_epi8(-1);
+  const __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(digit, minus_one), _mm_cmplt_epi8(digit, _mm_set1_epi8(10)));
+  const __m128i is_letter = _mm_and_si128(_mm_cmpgt_epi8(letter, minus_one), _mm_cmplt_epi8(letter, _mm_set1_epi8(6)));
+  if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xffff) return false;
+
+  values = _mm_or_si128(_mm_and_si128(is_digit, digit),
+                        _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+  return true;
+}
+
+// 32 个字符 -> 16 字节
+UTILS_TARGET("ssse3") size_t decode_ssse3(const char *in, size_t len, unsigned char *out)
+{
+  // 每对 4 bit 值 (高, 低) 乘以 (16, 1) 相加
+  const __m128i weights = _mm_set1_epi16(0x0110);
+  size_t pos = 0;
+  for (; len - pos >= 32; pos += 32)
+  {
+    __m128i a;
+    __m128i b;
+    if (!values_128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + pos)), a) ||
+        !values_128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + pos + 16)), b))
+    {
+      break;
+    }
+    const __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(a, weights), _mm_maddubs_epi16(b, weights));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + pos / 2), bytes);
+  }
+  return pos;
+}
+
+UTILS_TARGET("avx2") inline bool values_256(__m256i v, __m256i &values)
+{
+  const __m256i digit = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+  const __m256i letter = _mm256_sub_epi8(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+  const __m256i minus_one = _mm256_set1_epi8(-1);
+  const __m256i is_digit =
+    _mm256_and_si256(_mm256_cmpgt_epi8(digit, minus_one), _mm256_cmpgt_epi8(_mm256_set1_epi8(10), digit));
+  const __m256i is_letter =
+    _mm256_and_si256(_mm256_cmpgt_epi8(letter, minus_one), _mm256_cmpgt_epi8(_mm256_set1_epi8(6), letter));
+  if (_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)) != -1) return false;
+
+  values = _mm256_or_si256(_mm256_and_si256(is_digit, digit),
+                           _mm256_and_si256(is_letter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+  return true;
+}
+
+// 64 个字符 -> 32 字节
+UTILS_TARGET("avx2") size_t decode_avx2(const char *in, size_t len, unsigned char *out)
+{
+  const __m256i weights = _mm256_set1_epi16(0x0110);
+  size_t pos = 0;
+  for (; len - pos >= 64; pos += 64)
+  {
+    __m256i a;
+    __m256i b;
+    if (!values_256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + pos)), a) ||
+        !values_256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + pos + 32)), b))
+    {
+      break;
+    }
+    // packus 在通道内交错两个输入, 用 permute4x64 恢复顺序
+    const __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(a, weights), _mm256_maddubs_epi16(b, weights));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + pos / 2), _mm256_permute4x64_epi64(packed, 0xD8));
+  }
+  _mm256_zeroupper();
+  return pos + decode_ssse3(in + pos, len - pos, out + pos / 2);
+}
+#endif  // UTILS_X86_SIMD
+
+encode_kernel select_encode_kernel()
+{
+#if UTILS_X86_SIMD
+  const cpu::feature_set &f = cpu::features();
+  if (f.avx2) return encode_avx2;
+  if (f.ssse3) return encode_ssse3;
+#endif  // UTILS_X86_SIMD
+  return nullptr;
+}
+
+decode_kernel select_decode_kernel()
+{
+#if UTILS_X86_SIMD
+  const cpu::feature_set &f = cpu::features();
+  if (f.avx2) return decode_avx2;
+  if (f.ssse3) return decode_ssse3;
+#endif  // UTILS_X86_SIMD
+  return nullptr;
+}
+
+// 写入 2 * len 个字符
+void encode_into(const unsigned char *in, size_t len, char *out, bool uppercase)
+{
+  static const encode_kernel kernel = select_encode_kernel();
+
+  size_t pos = kernel != nullptr ? kernel(in, len, out, uppercase) : 0;
+  for (; pos < len; ++pos)
+  {
+    out[2 * pos] = hex_digit(in[pos] >> 4, uppercase);
+    out[2 * pos + 1] = hex_digit(in[pos], uppercase);
+  }
+}
+
+// 写入 len / 2 个字节; 非法输入时抛出 hex_error
+void decode_into(const char *in, size_t len, unsigned char *out)
+{
+  static const decode_kernel kernel = select_decode_kernel();
+
+  size_t pos = kernel != nullptr ? kernel(in, len, out) : 0;
+  for (; pos + 2 <= len; pos += 2)
+  {
+    const int hi = hex_value(in[pos]);
+    const int lo = hex_value(in[pos + 1]);
+    if (hi < 0 || lo < 0) throw hex_error(hi < 0 ? pos : pos + 1);
+    out[pos / 2] = static_cast<unsigned char>((hi << 4) | lo);
+  }
+  if (pos < len) throw hex_error(pos);  // 奇数长度, 最后一个字符不成对
+}
+}  // namespace
+
+// ---------------- 编码 ----------------
+std::string hex_encode(const unsigned char *data, size_t len, bool uppercase)
+{
+  std::string result(2 * len, '\0');
+  if (len != 0) encode_into(data, len, &result[0], uppercase);
+  return result;
+}
+
+std::string hex_encode(const std::string &data, bool uppercase)
+{
+  return hex_encode(reinterpret_cast<const unsigned char *>(data.data()), data.size(), uppercase);
+}
+
+size_t hex_encode_to(const unsigned char *data, size_t len, char *out, size_t out_capacity, bool uppercase)
+{
+  if (out_capacity / 2 < len) throw std::length_error("hex_encode_to: output buffer too small");
+  encode_into(data, len, out, uppercase);
+  return 2 * len;
+}
+
+// ---------------- 解码 ----------------
+std::string hex_decode(const char *hex, size_t len)
+{
+  std::string result(len / 2, '\0');
+  if (len != 0) decode_into(hex, len, reinterpret_cast<unsigned char *>(&result[0]));
+  return result;
+}
+
+std::string hex_decode(const std::string &hex)
+{
+  return hex_decode(hex.data(), hex.size());
+}
+
+size_t hex_decode_to(const char *hex, size_t len, unsigned char *out, size_t out_capacity)
+{
+  if (out_capacity < len / 2) throw std::length_error("hex_decode_to: output buffer too small");
+  decode_into(hex, len, out);
+  return len / 2;
+}
+
+}  // namespace codec
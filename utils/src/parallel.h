@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file parallel.h
+ * @brief 把大块输入分段交给多个线程处理的辅助函数（库内部使用，不对外安装）
+ *
+ * base64 的多线程编解码与文件 CRC 的分段计算共用: 先由 piece_count 决定段数,
+ * 再由 run 在调用线程与新线程上运行各段.
+ *
+ * @author abin
+ * @date 2025-12-08
+ */
+
+#ifndef __GUARD_PARALLEL_H_INCLUDE_GUARD__
+#define __GUARD_PARALLEL_H_INCLUDE_GUARD__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace parallel
+{
+
+// size 字节的输入分成的段数, 1 表示在调用线程上处理; 每段不小于 min_piece, 使启动线程的开销可以忽略.
+// threads 为 0 时使用硬件线程数
+inline uint64_t piece_count(uint64_t size, unsigned int threads, uint64_t threshold, uint64_t min_piece)
+{
+  if (size < threshold) return 1;
+  if (threads == 0) threads = std::thread::hardware_concurrency();
+  return std::max<uint64_t>(1, std::min<uint64_t>(threads, size / min_piece));
+}
+
+// 运行 work(0) ... work(pieces - 1), 第 0 段在调用线程上; 无法启动线程的段同样在调用线程上运行
+template <typename Work>
+void run(size_t pieces, const Work &work)
+{
+  std::vector<std::thread> workers;
+  workers.reserve(pieces - 1);
+
+  size_t next = 1;
+  try
+  {
+    for (; next < pieces; ++next) workers.emplace_back(work, next);
+  }
+  catch (const std::system_error &)
+  {
+  }
+
+  for (size_t i = next; i < pieces; ++i) work(i);
+  work(0);
+
+  for (std::thread &worker : workers) worker.join();
+}
+
+}  // namespace parallel
+
+#endif  // __GUARD_PARALLEL_H_INCLUDE_GUARD__
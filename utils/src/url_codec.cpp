@@ -3,12 +3,13 @@
 #include <cctype>
 #include <stdexcept>
 
+#include "utils/hex.h"
+
 namespace codec
 {
 
 std::string url_encode(const std::string &value)
 {
-  static const char hex[] = "0123456789ABCDEF";
   std::string result;
   result.reserve(value.size() * 3);  // 最坏情况，每个字符变成 %XX
 
@@ -21,8 +22,8 @@ std::string url_encode(const std::string &value)
     else
     {
       result.push_back('%');
-      result.push_back(hex[c >> 4]);
-      result.push_back(hex[c & 0x0F]);
+      result.push_back(hex_digit(c >> 4, true));
+      result.push_back(hex_digit(c, true));
     }
   }
 
@@ -39,13 +40,10 @@ std::string url_decode(const std::string &value)
   {
     if (value[i] == '%' && i + 2 < value.size())
     {
-      auto hex_digit = [](char c) -> int {
-        if (c >= '0' && c <= '9') return c - '0';
-        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
-        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
-        throw std::runtime_error("Invalid percent-encoding");
-      };
-      unsigned char decoded_char = (hex_digit(value[i + 1]) << 4) | hex_digit(value[i + 2]);
+      const int hi = hex_value(value[i + 1]);
+      const int lo = hex_value(value[i + 2]);
+      if (hi < 0 || lo < 0) throw std::runtime_error("Invalid percent-encoding");
+      unsigned char decoded_char = static_cast<unsigned char>((hi << 4) | lo);
       result.push_back(static_cast<char>(decoded_char));
       i += 3;
     }
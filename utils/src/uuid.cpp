@@ -1,12 +1,13 @@
 #include "utils/uuid.h"
 
-#include <fmt/core.h>
-
 #include <chrono>
 #include <cstdint>
+#include <cstring>
 #include <random>
 #include <thread>
 
+#include "utils/hex.h"
+
 namespace uuid
 {
 
@@ -23,12 +24,27 @@ std::string uuidv4()
 
   uint64_t hi = dis(gen);
   uint64_t lo = dis(gen);
-  char buf[37]{};
-  auto result = fmt::format_to_n(
-    buf, sizeof(buf), "{:08x}-{:04x}-{:04x}-{:04x}-{:012x}", static_cast<uint32_t>(hi >> 32),
-    static_cast<uint16_t>((hi >> 16) & 0xFFFF), static_cast<uint16_t>((hi & 0x0FFF) | 0x4000),
-    static_cast<uint16_t>((lo >> 48 & 0x3FFF) | 0x8000), static_cast<uint64_t>(lo & 0xFFFFFFFFFFFFULL));
-  return std::string(buf, result.out);
+
+  // 16 字节按大端顺序排列, 设置版本 (4) 与变体 (10xx) 位
+  unsigned char bytes[16];
+  for (int i = 0; i < 8; ++i)
+  {
+    bytes[i] = static_cast<unsigned char>(hi >> (56 - 8 * i));
+    bytes[8 + i] = static_cast<unsigned char>(lo >> (56 - 8 * i));
+  }
+  bytes[6] = static_cast<unsigned char>((bytes[6] & 0x0F) | 0x40);
+  bytes[8] = static_cast<unsigned char>((bytes[8] & 0x3F) | 0x80);
+
+  // 8-4-4-4-12
+  char hex[32];
+  codec::hex_encode_to(bytes, sizeof(bytes), hex, sizeof(hex));
+  std::string result(36, '-');
+  std::memcpy(&result[0], hex, 8);
+  std::memcpy(&result[9], hex + 8, 4);
+  std::memcpy(&result[14], hex + 12, 4);
+  std::memcpy(&result[19], hex + 16, 4);
+  std::memcpy(&result[24], hex + 20, 12);
+  return result;
 }
 
 }  // namespace uuid
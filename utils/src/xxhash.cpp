@@ -0,0 +1,704 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file xxhash.cpp
+ * @brief xxHash (XXH64 / XXH3) 非加密哈希
+ *
+ * 算法与常量来自 xxHash 参考实现 (https://github.com/Cyan4973/xxHash, BSD-2-Clause),
+ * 结果与其 XXH64(), XXH3_64bits_withSeed(), XXH3_128bits_withSeed() 以及对应的流式接口一致.
+ * XXH3 长输入的 stripe 累加按 CPU 特性分派到 SSE2 / AVX2 内核 (xxhash_simd.cpp), 其余部分为标量代码.
+ *
+ * @author abin
+ * @date 2025-12-17
+ */
+
+#include <cstring>
+
+#include "utils/check.h"
+#include "xxhash_simd.h"
+
+namespace checkutils
+{
+
+namespace
+{
+const uint64_t prime32_1 = 0x9E3779B1U;
+const uint64_t prime32_2 = 0x85EBCA77U;
+const uint64_t prime32_3 = 0xC2B2AE3DU;
+const uint64_t prime64_1 = 0x9E3779B185EBCA87ULL;
+const uint64_t prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+const uint64_t prime64_3 = 0x165667B19E3779F9ULL;
+const uint64_t prime64_4 = 0x85EBCA77C2B2AE63ULL;
+const uint64_t prime64_5 = 0x27D4EB2F165667C5ULL;
+const uint64_t prime_mx1 = 0x165667919E3779F9ULL;
+const uint64_t prime_mx2 = 0x9FB21C651E98DF25ULL;
+
+// XXH3 默认密钥 (取自 FARSH), 带种子时每 16 字节的前后 8 字节分别加、减种子
+const unsigned char default_secret[192] = {
+  0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+  0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+  0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+  0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+  0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+  0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+  0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+  0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+  0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+  0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+  0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+  0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+const size_t secret_size = sizeof(default_secret);
+const size_t stripe_len = detail::xxh3_stripe_len;                    // 每个 stripe 更新一次 8 个累加器
+const size_t secret_consume_rate = detail::xxh3_secret_consume_rate;  // 每个 stripe 密钥前进的字节数
+const size_t stripes_per_block = (secret_size - stripe_len) / secret_consume_rate;  // 每块之后打散一次累加器
+const size_t block_len = stripe_len * stripes_per_block;
+const size_t midsize_max = 240;  // 不超过该长度的输入不使用累加器
+const size_t midsize_start_offset = 3;
+const size_t midsize_last_offset = 17;
+const size_t secret_size_min = 136;
+const size_t last_acc_start = 7;
+const size_t merge_accs_start = 11;
+
+// ---------------- 基本运算 ----------------
+inline uint64_t swap64(uint64_t v)
+{
+  return ((v << 56) & 0xff00000000000000ULL) | ((v << 40) & 0x00ff000000000000ULL) |
+         ((v << 24) & 0x0000ff0000000000ULL) | ((v << 8) & 0x000000ff00000000ULL) |
+         ((v >> 8) & 0x00000000ff000000ULL) | ((v >> 24) & 0x0000000000ff0000ULL) |
+         ((v >> 40) & 0x000000000000ff00ULL) | ((v >> 56) & 0x00000000000000ffULL);
+}
+
+inline uint32_t swap32(uint32_t v)
+{
+  return ((v << 24) & 0xff000000U) | ((v << 8) & 0x00ff0000U) | ((v >> 8) & 0x0000ff00U) | ((v >> 24) & 0x000000ffU);
+}
+
+inline uint64_t read64(const unsigned char *p)
+{
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = swap64(v);
+#endif
+  return v;
+}
+
+inline uint32_t read32(const unsigned char *p)
+{
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = swap32(v);
+#endif
+  return v;
+}
+
+inline void write64(unsigned char *p, uint64_t v)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = swap64(v);
+#endif
+  std::memcpy(p, &v, sizeof(v));
+}
+
+inline uint64_t rotl64(uint64_t v, int r)
+{
+  return (v << r) | (v >> (64 - r));
+}
+
+inline uint32_t rotl32(uint32_t v, int r)
+{
+  return (v << r) | (v >> (32 - r));
+}
+
+inline uint64_t xorshift64(uint64_t v, int shift)
+{
+  return v ^ (v >> shift);
+}
+
+// 64 x 64 -> 128 bit 乘法
+inline hash128 mult64to128(uint64_t a, uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+  // __extension__: -Wpedantic 下 __int128 不是标准类型
+  __extension__ typedef unsigned __int128 uint128;
+  const uint128 product = static_cast<uint128>(a) * b;
+  return hash128{static_cast<uint64_t>(product), static_cast<uint64_t>(product >> 64)};
+#else
+  const uint64_t lo_lo = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+  const uint64_t hi_lo = (a >> 32) * (b & 0xFFFFFFFF);
+  const uint64_t lo_hi = (a & 0xFFFFFFFF) * (b >> 32);
+  const uint64_t hi_hi = (a >> 32) * (b >> 32);
+  const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+  return hash128{(cross << 32) | (lo_lo & 0xFFFFFFFF), hi_hi + (hi_lo >> 32) + (cross >> 32)};
+#endif
+}
+
+inline uint64_t mul128_fold64(uint64_t a, uint64_t b)
+{
+  const hash128 product = mult64to128(a, b);
+  return product.low ^ product.high;
+}
+
+// ---------------- XXH64 ----------------
+inline uint64_t xxh64_round(uint64_t acc, uint64_t input)
+{
+  acc += input * prime64_2;
+  acc = rotl64(acc, 31);
+  return acc * prime64_1;
+}
+
+inline uint64_t xxh64_merge_round(uint64_t acc, uint64_t val)
+{
+  acc ^= xxh64_round(0, val);
+  return acc * prime64_1 + prime64_4;
+}
+
+inline uint64_t xxh64_avalanche(uint64_t h)
+{
+  h ^= h >> 33;
+  h *= prime64_2;
+  h ^= h >> 29;
+  h *= prime64_3;
+  h ^= h >> 32;
+  return h;
+}
+
+inline uint64_t xxh64_merge(const uint64_t *v)
+{
+  uint64_t h = rotl64(v[0], 1) + rotl64(v[1], 7) + rotl64(v[2], 12) + rotl64(v[3], 18);
+  for (int i = 0; i < 4; ++i) h = xxh64_merge_round(h, v[i]);
+  return h;
+}
+
+// 不足 32 字节的尾部
+uint64_t xxh64_finalize(uint64_t h, const unsigned char *p, size_t len)
+{
+  len &= 31;
+  for (; len >= 8; len -= 8, p += 8)
+  {
+    h ^= xxh64_round(0, read64(p));
+    h = rotl64(h, 27) * prime64_1 + prime64_4;
+  }
+  if (len >= 4)
+  {
+    h ^= static_cast<uint64_t>(read32(p)) * prime64_1;
+    h = rotl64(h, 23) * prime64_2 + prime64_3;
+    p += 4;
+    len -= 4;
+  }
+  for (; len > 0; --len, ++p)
+  {
+    h ^= *p * prime64_5;
+    h = rotl64(h, 11) * prime64_1;
+  }
+  return xxh64_avalanche(h);
+}
+
+inline void xxh64_init(uint64_t *v, uint64_t seed)
+{
+  v[0] = seed + prime64_1 + prime64_2;
+  v[1] = seed + prime64_2;
+  v[2] = seed;
+  v[3] = seed - prime64_1;
+}
+
+// 四个累加器各取 8 字节, 返回处理的字节数 (32 的整数倍)
+size_t xxh64_consume(uint64_t *v, const unsigned char *p, size_t len)
+{
+  uint64_t v0 = v[0];
+  uint64_t v1 = v[1];
+  uint64_t v2 = v[2];
+  uint64_t v3 = v[3];
+  size_t pos = 0;
+  for (; len - pos >= 32; pos += 32)
+  {
+    v0 = xxh64_round(v0, read64(p + pos));
+    v1 = xxh64_round(v1, read64(p + pos + 8));
+    v2 = xxh64_round(v2, read64(p + pos + 16));
+    v3 = xxh64_round(v3, read64(p + pos + 24));
+  }
+  v[0] = v0;
+  v[1] = v1;
+  v[2] = v2;
+  v[3] = v3;
+  return pos;
+}
+
+uint64_t xxh64_oneshot(const unsigned char *p, size_t len, uint64_t seed)
+{
+  uint64_t h;
+  size_t done = 0;
+  if (len >= 32)
+  {
+    uint64_t v[4];
+    xxh64_init(v, seed);
+    done = xxh64_consume(v, p, len);
+    h = xxh64_merge(v);
+  }
+  else
+  {
+    h = seed + prime64_5;
+  }
+  return xxh64_finalize(h + len, p + done, len);
+}
+
+// ---------------- XXH3 短输入 (不超过 240 字节) ----------------
+inline uint64_t xxh3_avalanche(uint64_t h)
+{
+  h = xorshift64(h, 37);
+  h *= prime_mx1;
+  return xorshift64(h, 32);
+}
+
+inline uint64_t rrmxmx(uint64_t h, uint64_t len)
+{
+  h ^= rotl64(h, 49) ^ rotl64(h, 24);
+  h *= prime_mx2;
+  h ^= (h >> 35) + len;
+  h *= prime_mx2;
+  return xorshift64(h, 28);
+}
+
+inline uint64_t mix16(const unsigned char *p, const unsigned char *secret, uint64_t seed)
+{
+  return mul128_fold64(read64(p) ^ (read64(secret) + seed), read64(p + 8) ^ (read64(secret + 8) - seed));
+}
+
+inline hash128 mix32(hash128 acc, const unsigned char *p1, const unsigned char *p2, const unsigned char *secret,
+                     uint64_t seed)
+{
+  acc.low += mix16(p1, secret, seed);
+  acc.low ^= read64(p2) + read64(p2 + 8);
+  acc.high += mix16(p2, secret + 16, seed);
+  acc.high ^= read64(p1) + read64(p1 + 8);
+  return acc;
+}
+
+uint64_t xxh3_64_0to16(const unsigned char *p, size_t len, const unsigned char *secret, uint64_t seed)
+{
+  if (len > 8)
+  {
+    const uint64_t bitflip1 = (read64(secret + 24) ^ read64(secret + 32)) + seed;
+    const uint64_t bitflip2 = (read64(secret + 40) ^ read64(secret + 48)) - seed;
+    const uint64_t lo = read64(p) ^ bitflip1;
+    const uint64_t hi = read64(p + len - 8) ^ bitflip2;
+    return xxh3_avalanche(len + swap64(lo) + hi + mul128_fold64(lo, hi));
+  }
+  if (len >= 4)
+  {
+    seed ^= static_cast<uint64_t>(swap32(static_cast<uint32_t>(seed))) << 32;
+    const uint64_t bitflip = (read64(secret + 8) ^ read64(secret + 16)) - seed;
+    const uint64_t input = read32(p + len - 4) + (static_cast<uint64_t>(read32(p)) << 32);
+    return rrmxmx(input ^ bitflip, len);
+  }
+  if (len > 0)
+  {
+    const uint32_t combined = (static_cast<uint32_t>(p[0]) << 16) | (static_cast<uint32_t>(p[len >> 1]) << 24) |
+                              static_cast<uint32_t>(p[len - 1]) | (static_cast<uint32_t>(len) << 8);
+    const uint64_t bitflip = (read32(secret) ^ read32(secret + 4)) + seed;
+    return xxh64_avalanche(combined ^ bitflip);
+  }
+  return xxh64_avalanche(seed ^ (read64(secret + 56) ^ read64(secret + 64)));
+}
+
+uint64_t xxh3_64_17to240(const unsigned char *p, size_t len, const unsigned char *secret, uint64_t seed)
+{
+  uint64_t acc = len * prime64_1;
+  if (len <= 128)
+  {
+    // 首尾各取 16 字节一对, 由外向内
+    for (size_t i = 0; i <= (len - 1) / 32; ++i)
+    {
+      acc += mix16(p + 16 * i, secret + 32 * i, seed);
+      acc += mix16(p + len - 16 * (i + 1), secret + 32 * i + 16, seed);
+    }
+    return xxh3_avalanche(acc);
+  }
+
+  const size_t rounds = len / 16;
+  for (size_t i = 0; i < 8; ++i) acc += mix16(p + 16 * i, secret + 16 * i, seed);
+  uint64_t acc_end = mix16(p + len - 16, secret + secret_size_min - midsize_last_offset, seed);
+  acc = xxh3_avalanche(acc);
+  for (size_t i = 8; i < rounds; ++i) acc_end += mix16(p + 16 * i, secret + 16 * (i - 8) + midsize_start_offset, seed);
+  return xxh3_avalanche(acc + acc_end);
+}
+
+hash128 xxh3_128_0to16(const unsigned char *p, size_t len, const unsigned char *secret, uint64_t seed)
+{
+  if (len > 8)
+  {
+    const uint64_t bitflipl = (read64(secret + 32) ^ read64(secret + 40)) - seed;
+    const uint64_t bitfliph = (read64(secret + 48) ^ read64(secret + 56)) + seed;
+    const uint64_t input_lo = read64(p);
+    uint64_t input_hi = read64(p + len - 8);
+    hash128 m = mult64to128(input_lo ^ input_hi ^ bitflipl, prime64_1);
+    m.low += static_cast<uint64_t>(len - 1) << 54;
+    input_hi ^= bitfliph;
+    m.high += input_hi + (input_hi & 0xFFFFFFFF) * (prime32_2 - 1);
+    m.low ^= swap64(m.high);
+
+    hash128 h = mult64to128(m.low, prime64_2);
+    h.high += m.high * prime64_2;
+    return hash128{xxh3_avalanche(h.low), xxh3_avalanche(h.high)};
+  }
+  if (len >= 4)
+  {
+    seed ^= static_cast<uint64_t>(swap32(static_cast<uint32_t>(seed))) << 32;
+    const uint64_t input = read32(p) + (static_cast<uint64_t>(read32(p + len - 4)) << 32);
+    const uint64_t bitflip = (read64(secret + 16) ^ read64(secret + 24)) + seed;
+    hash128 m = mult64to128(input ^ bitflip, prime64_1 + (len << 2));
+    m.high += m.low << 1;
+    m.low ^= m.high >> 3;
+    m.low = xorshift64(m.low, 35);
+    m.low *= prime_mx2;
+    m.low = xorshift64(m.low, 28);
+    m.high = xxh3_avalanche(m.high);
+    return m;
+  }
+  if (len > 0)
+  {
+    const uint32_t combinedl = (static_cast<uint32_t>(p[0]) << 16) | (static_cast<uint32_t>(p[len >> 1]) << 24) |
+                               static_cast<uint32_t>(p[len - 1]) | (static_cast<uint32_t>(len) << 8);
+    const uint32_t combinedh = rotl32(swap32(combinedl), 13);
+    const uint64_t bitflipl = (read32(secret) ^ read32(secret + 4)) + seed;
+    const uint64_t bitfliph = (read32(secret + 8) ^ read32(secret + 12)) - seed;
+    return hash128{xxh64_avalanche(combinedl ^ bitflipl), xxh64_avalanche(combinedh ^ bitfliph)};
+  }
+  return hash128{xxh64_avalanche(seed ^ read64(secret + 64) ^ read64(secret + 72)),
+                 xxh64_avalanche(seed ^ read64(secret + 80) ^ read64(secret + 88))};
+}
+
+hash128 xxh3_128_17to240(const unsigned char *p, size_t len, const unsigned char *secret, uint64_t seed)
+{
+  hash128 acc = {len * prime64_1, 0};
+  if (len <= 128)
+  {
+    for (size_t i = (len - 1) / 32 + 1; i-- > 0;)
+      acc = mix32(acc, p + 16 * i, p + len - 16 * (i + 1), secret + 32 * i, seed);
+  }
+  else
+  {
+    for (size_t i = 32; i < 160; i += 32) acc = mix32(acc, p + i - 32, p + i - 16, secret + i - 32, seed);
+    acc.low = xxh3_avalanche(acc.low);
+    acc.high = xxh3_avalanche(acc.high);
+    for (size_t i = 160; i <= len; i += 32)
+      acc = mix32(acc, p + i - 32, p + i - 16, secret + midsize_start_offset + i - 160, seed);
+    acc = mix32(acc, p + len - 16, p + len - 32, secret + secret_size_min - midsize_last_offset - 16, 0 - seed);
+  }
+
+  const uint64_t low = acc.low + acc.high;
+  const uint64_t high = acc.low * prime64_1 + acc.high * prime64_4 + (len - seed) * prime64_2;
+  return hash128{xxh3_avalanche(low), 0 - xxh3_avalanche(high)};
+}
+
+// ---------------- XXH3 长输入 ----------------
+// 每个 stripe: 8 个 64 bit 累加器各自加上 (数据 ^ 密钥) 高低 32 bit 之积, 相邻累加器交换加上原始数据
+void accumulate_scalar(uint64_t *acc, const unsigned char *input, const unsigned char *secret, size_t stripes)
+{
+  for (size_t n = 0; n < stripes; ++n)
+  {
+    const unsigned char *in = input + n * stripe_len;
+    const unsigned char *key = secret + n * secret_consume_rate;
+    for (size_t i = 0; i < 8; ++i)
+    {
+      const uint64_t data = read64(in + 8 * i);
+      const uint64_t data_key = data ^ read64(key + 8 * i);
+      acc[i ^ 1] += data;
+      acc[i] += (data_key & 0xFFFFFFFF) * (data_key >> 32);
+    }
+  }
+}
+
+detail::xxh3_accumulate_kernel select_accumulate_kernel()
+{
+#if UTILS_X86_SIMD
+  const cpu::feature_set &f = cpu::features();
+  if (f.avx2) return detail::xxh3_accumulate_avx2;
+  if (f.sse2) return detail::xxh3_accumulate_sse2;
+#endif  // UTILS_X86_SIMD
+  return accumulate_scalar;
+}
+
+void accumulate(uint64_t *acc, const unsigned char *input, const unsigned char *secret, size_t stripes)
+{
+  static const detail::xxh3_accumulate_kernel kernel = select_accumulate_kernel();
+  kernel(acc, input, secret, stripes);
+}
+
+// 每块结束时打散累加器, 每块只执行一次, 标量即可
+void scramble(uint64_t *acc, const unsigned char *secret)
+{
+  for (size_t i = 0; i < 8; ++i)
+  {
+    uint64_t a = xorshift64(acc[i], 47);
+    a ^= read64(secret + 8 * i);
+    acc[i] = a * prime32_1;
+  }
+}
+
+void init_acc(uint64_t *acc)
+{
+  const uint64_t init[8] = {prime32_3, prime64_1, prime64_2, prime64_3, prime64_4, prime32_2, prime64_5, prime32_1};
+  std::memcpy(acc, init, sizeof(init));
+}
+
+void init_secret(unsigned char *secret, uint64_t seed)
+{
+  for (size_t i = 0; i < secret_size; i += 16)
+  {
+    write64(secret + i, read64(default_secret + i) + seed);
+    write64(secret + i + 8, read64(default_secret + i + 8) - seed);
+  }
+}
+
+uint64_t merge_accs(const uint64_t *acc, const unsigned char *secret, uint64_t start)
+{
+  uint64_t result = start;
+  for (size_t i = 0; i < 4; ++i)
+    result += mul128_fold64(acc[2 * i] ^ read64(secret + 16 * i), acc[2 * i + 1] ^ read64(secret + 16 * i + 8));
+  return xxh3_avalanche(result);
+}
+
+inline uint64_t merge_low(const uint64_t *acc, const unsigned char *secret, uint64_t len)
+{
+  return merge_accs(acc, secret + merge_accs_start, len * prime64_1);
+}
+
+inline uint64_t merge_high(const uint64_t *acc, const unsigned char *secret, uint64_t len)
+{
+  return merge_accs(acc, secret + secret_size - 64 - merge_accs_start, ~(len * prime64_2));
+}
+
+// 一次性处理超过 240 字节的完整输入; 最后一个 stripe 总是取输入末尾的 64 字节
+void hash_long(uint64_t *acc, const unsigned char *p, size_t len, const unsigned char *secret)
+{
+  init_acc(acc);
+  const size_t blocks = (len - 1) / block_len;
+  for (size_t n = 0; n < blocks; ++n)
+  {
+    accumulate(acc, p + n * block_len, secret, stripes_per_block);
+    scramble(acc, secret + secret_size - stripe_len);
+  }
+
+  const size_t stripes = ((len - 1) - block_len * blocks) / stripe_len;
+  accumulate(acc, p + blocks * block_len, secret, stripes);
+  accumulate(acc, p + len - stripe_len, secret + secret_size - stripe_len - last_acc_start, 1);
+}
+
+// 流式输入: 从块内第 stripes 个 stripe 继续累加, 返回处理到的位置
+const unsigned char *consume_stripes(uint64_t *acc, size_t &stripes_so_far, const unsigned char *p, size_t stripes,
+                                     const unsigned char *secret)
+{
+  const unsigned char *key = secret + stripes_so_far * secret_consume_rate;
+  if (stripes >= stripes_per_block - stripes_so_far)
+  {
+    size_t this_block = stripes_per_block - stripes_so_far;
+    do
+    {
+      accumulate(acc, p, key, this_block);
+      scramble(acc, secret + secret_size - stripe_len);
+      p += this_block * stripe_len;
+      stripes -= this_block;
+      this_block = stripes_per_block;
+      key = secret;
+    } while (stripes >= stripes_per_block);
+    stripes_so_far = 0;
+  }
+  if (stripes > 0)
+  {
+    accumulate(acc, p, key, stripes);
+    p += stripes * stripe_len;
+    stripes_so_far += stripes;
+  }
+  return p;
+}
+
+uint64_t xxh3_64_oneshot(const unsigned char *p, size_t len, uint64_t seed)
+{
+  if (len <= 16) return xxh3_64_0to16(p, len, default_secret, seed);
+  if (len <= midsize_max) return xxh3_64_17to240(p, len, default_secret, seed);
+
+  unsigned char secret[secret_size];
+  init_secret(secret, seed);
+  uint64_t acc[8];
+  hash_long(acc, p, len, secret);
+  return merge_low(acc, secret, len);
+}
+
+hash128 xxh3_128_oneshot(const unsigned char *p, size_t len, uint64_t seed)
+{
+  if (len <= 16) return xxh3_128_0to16(p, len, default_secret, seed);
+  if (len <= midsize_max) return xxh3_128_17to240(p, len, default_secret, seed);
+
+  unsigned char secret[secret_size];
+  init_secret(secret, seed);
+  uint64_t acc[8];
+  hash_long(acc, p, len, secret);
+  return hash128{merge_low(acc, secret, len), merge_high(acc, secret, len)};
+}
+
+const unsigned char *bytes(const std::string &data)
+{
+  return reinterpret_cast<const unsigned char *>(data.data());
+}
+}  // namespace
+
+// ---------------- XXH64 ----------------
+uint64_t xxh64(const std::string &data, uint64_t seed)
+{
+  return xxh64_oneshot(bytes(data), data.size(), seed);
+}
+
+xxh64_hasher::xxh64_hasher(uint64_t seed) noexcept :
+  seed_(seed)
+{
+  reset();
+}
+
+void xxh64_hasher::reset() noexcept
+{
+  xxh64_init(v_, seed_);
+  total_len_ = 0;
+  buffered_ = 0;
+}
+
+void xxh64_hasher::update(const void *data, size_t len)
+{
+  if (len == 0) return;
+  const unsigned char *p = static_cast<const unsigned char *>(data);
+  total_len_ += len;
+
+  if (buffered_ + len < sizeof(buffer_))
+  {
+    std::memcpy(buffer_ + buffered_, p, len);
+    buffered_ += len;
+    return;
+  }
+
+  if (buffered_ != 0)
+  {
+    const size_t fill = sizeof(buffer_) - buffered_;
+    std::memcpy(buffer_ + buffered_, p, fill);
+    xxh64_consume(v_, buffer_, sizeof(buffer_));
+    p += fill;
+    len -= fill;
+  }
+
+  const size_t done = xxh64_consume(v_, p, len);
+  buffered_ = len - done;
+  if (buffered_ != 0) std::memcpy(buffer_, p + done, buffered_);
+}
+
+uint64_t xxh64_hasher::value() const noexcept
+{
+  const uint64_t h = total_len_ >= 32 ? xxh64_merge(v_) : seed_ + prime64_5;
+  return xxh64_finalize(h + total_len_, buffer_, buffered_);
+}
+
+// ---------------- XXH3 ----------------
+uint64_t xxh3_64(const std::string &data, uint64_t seed)
+{
+  return xxh3_64_oneshot(bytes(data), data.size(), seed);
+}
+
+hash128 xxh3_128(const std::string &data, uint64_t seed)
+{
+  return xxh3_128_oneshot(bytes(data), data.size(), seed);
+}
+
+namespace detail
+{
+xxh3_state::xxh3_state(uint64_t seed) noexcept :
+  seed_(seed)
+{
+  init_secret(secret_, seed);
+  reset();
+}
+
+void xxh3_state::reset() noexcept
+{
+  init_acc(acc_);
+  buffered_ = 0;
+  stripes_ = 0;
+  total_len_ = 0;
+}
+
+// 缓冲区始终保留最后的输入 (至少 1 字节), 摘要时据此处理最后一个 stripe
+void xxh3_state::update(const unsigned char *data, size_t len)
+{
+  if (len == 0) return;
+  total_len_ += len;
+
+  if (len <= sizeof(buffer_) - buffered_)
+  {
+    std::memcpy(buffer_ + buffered_, data, len);
+    buffered_ += len;
+    return;
+  }
+
+  const unsigned char *end = data + len;
+  if (buffered_ != 0)
+  {
+    const size_t fill = sizeof(buffer_) - buffered_;
+    std::memcpy(buffer_ + buffered_, data, fill);
+    data += fill;
+    consume_stripes(acc_, stripes_, buffer_, sizeof(buffer_) / stripe_len, secret_);
+    buffered_ = 0;
+  }
+
+  if (static_cast<size_t>(end - data) > sizeof(buffer_))
+  {
+    data = consume_stripes(acc_, stripes_, data, static_cast<size_t>(end - 1 - data) / stripe_len, secret_);
+    // 剩余输入不足一个 stripe 时, 最后一个 stripe 需要向前借用已处理的数据
+    std::memcpy(buffer_ + sizeof(buffer_) - stripe_len, data - stripe_len, stripe_len);
+  }
+
+  buffered_ = static_cast<size_t>(end - data);
+  std::memcpy(buffer_, data, buffered_);
+}
+
+void xxh3_state::digest_long(uint64_t *acc) const noexcept
+{
+  std::memcpy(acc, acc_, sizeof(acc_));
+  unsigned char last_stripe[stripe_len];
+  const unsigned char *last = nullptr;
+  if (buffered_ >= stripe_len)
+  {
+    size_t stripes = stripes_;
+    consume_stripes(acc, stripes, buffer_, (buffered_ - 1) / stripe_len, secret_);
+    last = buffer_ + buffered_ - stripe_len;
+  }
+  else
+  {
+    const size_t catchup = stripe_len - buffered_;
+    std::memcpy(last_stripe, buffer_ + sizeof(buffer_) - catchup, catchup);
+    std::memcpy(last_stripe + catchup, buffer_, buffered_);
+    last = last_stripe;
+  }
+  accumulate(acc, last, secret_ + secret_size - stripe_len - last_acc_start, 1);
+}
+
+uint64_t xxh3_state::digest64() const noexcept
+{
+  if (total_len_ <= midsize_max) return xxh3_64_oneshot(buffer_, static_cast<size_t>(total_len_), seed_);
+
+  uint64_t acc[8];
+  digest_long(acc);
+  return merge_low(acc, secret_, total_len_);
+}
+
+hash128 xxh3_state::digest128() const noexcept
+{
+  if (total_len_ <= midsize_max) return xxh3_128_oneshot(buffer_, static_cast<size_t>(total_len_), seed_);
+
+  uint64_t acc[8];
+  digest_long(acc);
+  return hash128{merge_low(acc, secret_, total_len_), merge_high(acc, secret_, total_len_)};
+}
+}  // namespace detail
+
+}  // namespace checkutils
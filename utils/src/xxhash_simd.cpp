@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file xxhash_simd.cpp
+ * @brief XXH3 stripe 累加的 SSE2 与 AVX2 内核
+ *
+ * 每个 64 bit lane 计算 (数据 ^ 密钥) 高低 32 bit 之积 (pmuludq), 再加上相邻 lane 的原始数据 (pshufd 交换).
+ *
+ * @author abin
+ * @date 2025-12-17
+ */
+
+#include "xxhash_simd.h"
+
+#if UTILS_X86_SIMD
+
+namespace checkutils
+{
+namespace detail
+{
+namespace
+{
+UTILS_TARGET("sse2") inline __m128i accumulate_128(__m128i acc, __m128i data, __m128i key)
+{
+  const __m128i data_key = _mm_xor_si128(data, key);
+  const __m128i product = _mm_mul_epu32(data_key, _mm_srli_epi64(data_key, 32));
+  const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+  return _mm_add_epi64(product, _mm_add_epi64(acc, swapped));
+}
+
+UTILS_TARGET("avx2") inline __m256i accumulate_256(__m256i acc, __m256i data, __m256i key)
+{
+  const __m256i data_key = _mm256_xor_si256(data, key);
+  const __m256i product = _mm256_mul_epu32(data_key, _mm256_srli_epi64(data_key, 32));
+  const __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+  return _mm256_add_epi64(product, _mm256_add_epi64(acc, swapped));
+}
+}  // namespace
+
+UTILS_TARGET("sse2")
+void xxh3_accumulate_sse2(uint64_t *acc, const unsigned char *input, const unsigned char *secret, size_t stripes)
+{
+  __m128i *a = reinterpret_cast<__m128i *>(acc);
+  __m128i a0 = _mm_loadu_si128(a);
+  __m128i a1 = _mm_loadu_si128(a + 1);
+  __m128i a2 = _mm_loadu_si128(a + 2);
+  __m128i a3 = _mm_loadu_si128(a + 3);
+  for (size_t n = 0; n < stripes; ++n)
+  {
+    const __m128i *in = reinterpret_cast<const __m128i *>(input + n * xxh3_stripe_len);
+    const __m128i *key = reinterpret_cast<const __m128i *>(secret + n * xxh3_secret_consume_rate);
+    a0 = accumulate_128(a0, _mm_loadu_si128(in), _mm_loadu_si128(key));
+    a1 = accumulate_128(a1, _mm_loadu_si128(in + 1), _mm_loadu_si128(key + 1));
+    a2 = accumulate_128(a2, _mm_loadu_si128(in + 2), _mm_loadu_si128(key + 2));
+    a3 = accumulate_128(a3, _mm_loadu_si128(in + 3), _mm_loadu_si128(key + 3));
+  }
+  _mm_storeu_si128(a, a0);
+  _mm_storeu_si128(a + 1, a1);
+  _mm_storeu_si128(a + 2, a2);
+  _mm_storeu_si128(a + 3, a3);
+}
+
+UTILS_TARGET("avx2")
+void xxh3_accumulate_avx2(uint64_t *acc, const unsigned char *input, const unsigned char *secret, size_t stripes)
+{
+  __m256i *a = reinterpret_cast<__m256i *>(acc);
+  __m256i a0 = _mm256_loadu_si256(a);
+  __m256i a1 = _mm256_loadu_si256(a + 1);
+  for (size_t n = 0; n < stripes; ++n)
+  {
+    const __m256i *in = reinterpret_cast<const __m256i *>(input + n * xxh3_stripe_len);
+    const __m256i *key = reinterpret_cast<const __m256i *>(secret + n * xxh3_secret_consume_rate);
+    a0 = accumulate_256(a0, _mm256_loadu_si256(in), _mm256_loadu_si256(key));
+    a1 = accumulate_256(a1, _mm256_loadu_si256(in + 1), _mm256_loadu_si256(key + 1));
+  }
+  _mm256_storeu_si256(a, a0);
+  _mm256_storeu_si256(a + 1, a1);
+  _mm256_zeroupper();
+}
+
+}  // namespace detail
+}  // namespace checkutils
+
+#endif  // UTILS_X86_SIMD
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Abin
+
+/**
+ * @file xxhash_simd.h
+ * @brief XXH3 长输入 stripe 累加的 SIMD 内核（库内部使用，由 xxhash.cpp 在运行时按 CPU 特性分派）
+ *
+ * 每个 stripe (64 字节) 更新 8 个 64 bit 累加器, 下一个 stripe 的密钥前进 8 字节;
+ * 内核依次处理 stripes 个连续的 stripe.
+ *
+ * @author abin
+ * @date 2025-12-17
+ */
+
+#ifndef __GUARD_XXHASH_SIMD_H_INCLUDE_GUARD__
+#define __GUARD_XXHASH_SIMD_H_INCLUDE_GUARD__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cpu_features.h"
+
+namespace checkutils
+{
+namespace detail
+{
+
+const size_t xxh3_stripe_len = 64;
+const size_t xxh3_secret_consume_rate = 8;
+
+using xxh3_accumulate_kernel = void (*)(uint64_t *acc, const unsigned char *input, const unsigned char *secret,
+                                        size_t stripes);
+
+#if UTILS_X86_SIMD
+void xxh3_accumulate_sse2(uint64_t *acc, const unsigned char *input, const unsigned char *secret, size_t stripes);
+void xxh3_accumulate_avx2(uint64_t *acc, const unsigned char *input, const unsigned char *secret, size_t stripes);
+#endif  // UTILS_X86_SIMD
+
+}  // namespace detail
+}  // namespace checkutils
+
+#endif  // __GUARD_XXHASH_SIMD_H_INCLUDE_GUARD__